@@ -0,0 +1,235 @@
+/*!
+* @file AspectTree.cpp
+*
+* Class definitions: AspectTree
+*/
+
+#include "AspectTree.h"
+#include "Component_Aspect.h"
+#include "Frustum.h"
+#include "CommonMath.h"
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------
+//		Orders items by the center of their aspect sphere along one axis
+//--------------------------------------------------------------------------------
+struct CompareItemAxis
+{
+	CompareItemAxis(const Dg::map_sl<entityID, Component_ASPECT>& a_aspects, int a_axis)
+		: aspects(a_aspects), axis(a_axis) {}
+
+	template<typename T>
+	bool operator()(const T& a, const T& b) const
+	{
+		return aspects[a.aspect].sphere.current.Center()[axis] <
+			aspects[b.aspect].sphere.current.Center()[axis];
+	}
+
+	const Dg::map_sl<entityID, Component_ASPECT>& aspects;
+	int axis;
+};
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::Update()
+//--------------------------------------------------------------------------------
+//		Rebuild or refit the tree
+//--------------------------------------------------------------------------------
+void AspectTree::Update(const AspectMap& aspects)
+{
+	if (isDirty || items.size() != uint32(aspects.size()))
+	{
+		Rebuild(aspects);
+		return;
+	}
+
+	Refit(aspects);
+
+}	//End: AspectTree::Update()
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::Rebuild()
+//--------------------------------------------------------------------------------
+//		Build the tree from scratch
+//--------------------------------------------------------------------------------
+void AspectTree::Rebuild(const AspectMap& aspects)
+{
+	nodes.clear();
+	items.clear();
+
+	for (int i = 0; i < aspects.size(); ++i)
+	{
+		Item item;
+		item.aspect = uint32(i);
+		item.lastPlane = 0;
+		items.push_back(item);
+	}
+
+	if (items.size() > 0)
+		Build(0, items.size(), aspects);
+
+	isDirty = false;
+
+}	//End: AspectTree::Rebuild()
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::Build()
+//--------------------------------------------------------------------------------
+//		Build a subtree over a range of items, returns the node index
+//--------------------------------------------------------------------------------
+uint32 AspectTree::Build(uint32 first, uint32 count, const AspectMap& aspects)
+{
+	//Bounds of the range, and extent of the centers
+	Sphere bounds(aspects[items[first].aspect].sphere.current);
+	Point4 lower(bounds.Center());
+	Point4 upper(bounds.Center());
+
+	for (uint32 i = first + 1; i < first + count; ++i)
+	{
+		const Sphere& s = aspects[items[i].aspect].sphere.current;
+		bounds.Merge(s);
+
+		for (int j = 0; j < 3; ++j)
+		{
+			lower[j] = DgMin(lower[j], s.Center()[j]);
+			upper[j] = DgMax(upper[j], s.Center()[j]);
+		}
+	}
+
+	uint32 n = nodes.size();
+	Node node;
+	node.bounds = bounds;
+	node.first = first;
+	node.count = count;
+	node.right = 0;
+	node.isLeaf = (count <= LEAFSIZE);
+	node.lastPlane = 0;
+	nodes.push_back(node);
+
+	if (node.isLeaf)
+		return n;
+
+	//Split at the median along the widest axis
+	int axis = 0;
+	for (int j = 1; j < 3; ++j)
+	{
+		if (upper[j] - lower[j] > upper[axis] - lower[axis])
+			axis = j;
+	}
+
+	uint32 half = count / 2;
+	std::nth_element(items.Data() + first,
+		items.Data() + first + half,
+		items.Data() + first + count,
+		CompareItemAxis(aspects, axis));
+
+	Build(first, half, aspects);
+	uint32 right = Build(first + half, count - half, aspects);
+	nodes[n].right = right;
+
+	return n;
+
+}	//End: AspectTree::Build()
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::Refit()
+//--------------------------------------------------------------------------------
+//		Fit node spheres to the current aspect spheres. Children always
+//		come after their parent, so walk the nodes back to front.
+//--------------------------------------------------------------------------------
+void AspectTree::Refit(const AspectMap& aspects)
+{
+	for (uint32 n = nodes.size(); n-- > 0;)
+	{
+		Node& node = nodes[n];
+
+		if (node.isLeaf)
+		{
+			node.bounds = aspects[items[node.first].aspect].sphere.current;
+			for (uint32 i = node.first + 1; i < node.first + node.count; ++i)
+				node.bounds.Merge(aspects[items[i].aspect].sphere.current);
+		}
+		else
+		{
+			node.bounds = nodes[n + 1].bounds;
+			node.bounds.Merge(nodes[node.right].bounds);
+		}
+	}
+
+}	//End: AspectTree::Refit()
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::Cull()
+//--------------------------------------------------------------------------------
+//		Find all aspects touching the frustum
+//--------------------------------------------------------------------------------
+void AspectTree::Cull(const Frustum& frustum, AspectMap& aspects, DgArray<uint32>& out)
+{
+	//Aspects changed since the last update
+	if (isDirty || items.size() != uint32(aspects.size()))
+		Rebuild(aspects);
+
+	if (nodes.size() == 0)
+		return;
+
+	CullNode(0, frustum, Frustum::ALL_PLANES, aspects, out);
+
+}	//End: AspectTree::Cull()
+
+
+//--------------------------------------------------------------------------------
+//	@	AspectTree::CullNode()
+//--------------------------------------------------------------------------------
+//		Cull a subtree against the planes in the mask
+//--------------------------------------------------------------------------------
+void AspectTree::CullNode(uint32 n, const Frustum& frustum, uint8 planes,
+						  AspectMap& aspects, DgArray<uint32>& out)
+{
+	Node& node = nodes[n];
+
+	uint8 result = TestFrustumSphere(frustum, node.bounds, planes, node.lastPlane);
+	if (result == Frustum::OUTSIDE)
+		return;
+
+	//Whole subtree is inside
+	if (result == Frustum::INSIDE)
+	{
+		for (uint32 i = node.first; i < node.first + node.count; ++i)
+		{
+			aspects[items[i].aspect].intersects = Frustum::INSIDE;
+			out.push_back(items[i].aspect);
+		}
+		return;
+	}
+
+	//Children only need testing against the planes this node straddles
+	planes = result & ~Frustum::INSIDE;
+
+	if (!node.isLeaf)
+	{
+		CullNode(n + 1, frustum, planes, aspects, out);
+		CullNode(node.right, frustum, planes, aspects, out);
+		return;
+	}
+
+	for (uint32 i = node.first; i < node.first + node.count; ++i)
+	{
+		Item& item = items[i];
+		Component_ASPECT& aspect = aspects[item.aspect];
+
+		uint8 intersects = TestFrustumSphere(frustum, aspect.sphere.current,
+			planes, item.lastPlane);
+
+		if (intersects == Frustum::OUTSIDE)
+			continue;
+
+		aspect.intersects = intersects;
+		out.push_back(item.aspect);
+	}
+
+}	//End: AspectTree::CullNode()
@@ -0,0 +1,91 @@
+/*!
+* @file AspectTree.h
+*
+* Class header: AspectTree
+*/
+
+#ifndef ASPECTTREE_H
+#define ASPECTTREE_H
+
+#include "DgArray.h"
+#include "dg_map_sl.h"
+#include "DgTypes.h"
+#include "Sphere.h"
+
+class Frustum;
+class Component_ASPECT;
+
+/*!
+ * @ingroup entity_component
+ *
+ * @class AspectTree
+ *
+ * @brief A bounding sphere hierarchy over the aspects, used for frustum culling.
+ *
+ * The tree is built top-down by splitting aspects about the median of
+ * their centers along the widest axis. While the set of aspects stays the
+ * same, the node spheres are refitted to the current aspect spheres.
+ *
+ * Culling only tests the planes a node straddles against its children,
+ * and adds whole subtrees that are fully inside without testing them.
+ * Each node remembers the plane that last rejected it and tests it first.
+ */
+class AspectTree
+{
+	typedef Dg::map_sl<entityID, Component_ASPECT> AspectMap;
+
+public:
+	//Constructor / destructor
+	AspectTree(): isDirty(true) {}
+	~AspectTree() {}
+
+	//! Rebuild the tree on the next update, eg when aspects are added or removed.
+	void SetDirty() {isDirty = true;}
+
+	//! Rebuild if needed, otherwise refit the tree to the aspect spheres.
+	void Update(const AspectMap&);
+
+	/*!
+	* @brief Sets Component_ASPECT::intersects for every aspect touching
+	* the frustum, and appends their indices in the aspect map to the output.
+	* Aspects outside the frustum are not visited.
+	*/
+	void Cull(const Frustum&, AspectMap&, DgArray<uint32>& out);
+
+private:
+
+	struct Node
+	{
+		Sphere bounds;
+		uint32 first;		//Range of items under this node
+		uint32 count;
+		uint32 right;		//Right child. The left child follows its parent.
+		bool isLeaf;
+		uint8 lastPlane;	//Plane which last rejected the node
+	};
+
+	struct Item
+	{
+		uint32 aspect;		//Index into the aspect map
+		uint8 lastPlane;
+	};
+
+	//Maximum items in a leaf
+	static const uint32 LEAFSIZE = 4;
+
+private:
+	//Data members
+	DgArray<Node> nodes;
+	DgArray<Item> items;
+	bool isDirty;
+
+private:
+	//Functions
+	void Rebuild(const AspectMap&);
+	uint32 Build(uint32 first, uint32 count, const AspectMap&);
+	void Refit(const AspectMap&);
+	void CullNode(uint32, const Frustum&, uint8 planes, AspectMap&, DgArray<uint32>& out);
+
+};
+
+#endif
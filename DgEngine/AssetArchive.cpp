@@ -0,0 +1,303 @@
+/*!
+* @file AssetArchive.cpp
+*
+* Class definitions: AssetArchive
+*/
+
+#include "AssetArchive.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		File layout. Every block starts on a 16 byte boundary.
+//
+//		Header
+//		Entries			Entry[nEntries], sorted on (type, key)
+//		Names			Names of named entries, not terminated
+//		Data			Asset bytes
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char MAGIC[4] = {'D', 'G', 'P', 'K'};
+	const uint32 VERSION = 1;
+	const uint32 ALIGNMENT = 16;
+
+	struct Header
+	{
+		char magic[4];
+		uint32 version;
+		uint32 nEntries;
+		uint32 namesSize;
+	};
+
+	uint64 Aligned(uint64 n) {return (n + ALIGNMENT - 1) & ~uint64(ALIGNMENT - 1);}
+
+	//FNV-1a, keys named assets
+	uint32 NameKey(const std::string& name)
+	{
+		uint32 hash = 2166136261u;
+		for (size_t i = 0; i < name.size(); ++i)
+		{
+			hash ^= uint8(name[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+}
+
+struct AssetArchive::Entry
+{
+	uint32 type;
+	uint32 key;
+	uint32 nameOffset;
+	uint32 nameLength;
+	uint64 offset;		//From the start of the file
+	uint64 size;
+
+	bool operator<(const Entry& other) const 
+	{
+		return (type != other.type) ? (type < other.type) : (key < other.key);
+	}
+};
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Open()
+//--------------------------------------------------------------------------------
+//		Map an archive
+//--------------------------------------------------------------------------------
+bool AssetArchive::Open(const std::string& file)
+{
+	if (!map.Open(file) || map.Size() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	const Header* header = reinterpret_cast<const Header*>(map.Data());
+	if (memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION)
+	{
+		std::cerr << "@AssetArchive::Open() -> Not an archive: " << file << std::endl;
+		Close();
+		return false;
+	}
+
+	//Table of contents must fit, and all entries lie inside the file
+	uint64 namesStart = Aligned(sizeof(Header)) + uint64(header->nEntries) * sizeof(Entry);
+	if (Aligned(namesStart) + header->namesSize > map.Size())
+	{
+		std::cerr << "@AssetArchive::Open() -> File is truncated: " << file << std::endl;
+		Close();
+		return false;
+	}
+
+	const Entry* entries = Entries();
+	for (uint32 i = 0; i < header->nEntries; ++i)
+	{
+		const Entry& e = entries[i];
+		if (e.offset + e.size > map.Size() ||
+			uint64(e.nameOffset) + e.nameLength > header->namesSize)
+		{
+			std::cerr << "@AssetArchive::Open() -> Bad entry: " << file << std::endl;
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+
+}	//End: AssetArchive::Open()
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Close()
+//--------------------------------------------------------------------------------
+//		Unmap the archive
+//--------------------------------------------------------------------------------
+void AssetArchive::Close()
+{
+	map.Close();
+
+}	//End: AssetArchive::Close()
+
+
+//--------------------------------------------------------------------------------
+//		Table of contents in the mapping
+//--------------------------------------------------------------------------------
+const AssetArchive::Entry* AssetArchive::Entries() const
+{
+	return reinterpret_cast<const Entry*>(map.Data() + Aligned(sizeof(Header)));
+}
+
+uint32 AssetArchive::NumEntries() const
+{
+	return reinterpret_cast<const Header*>(map.Data())->nEntries;
+}
+
+const char* AssetArchive::Names() const
+{
+	uint64 start = Aligned(Aligned(sizeof(Header)) + uint64(NumEntries()) * sizeof(Entry));
+	return reinterpret_cast<const char*>(map.Data() + start);
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Find()
+//--------------------------------------------------------------------------------
+//		Binary search of the table of contents. If a name is given, it
+//		must match as well as the key.
+//--------------------------------------------------------------------------------
+bool AssetArchive::Find(Type type, uint32 key, const std::string* name, Blob& blob) const
+{
+	if (!IsOpen())
+		return false;
+
+	Entry target;
+	target.type = type;
+	target.key = key;
+
+	const Entry* first = Entries();
+	const Entry* last = first + NumEntries();
+	const Entry* it = std::lower_bound(first, last, target);
+
+	for (; it != last && it->type == uint32(type) && it->key == key; ++it)
+	{
+		if (name != NULL && 
+			(it->nameLength != name->size() ||
+			 memcmp(Names() + it->nameOffset, name->data(), name->size()) != 0))
+			continue;
+
+		blob.data = map.Data() + it->offset;
+		blob.size = size_t(it->size);
+		return true;
+	}
+
+	return false;
+
+}	//End: AssetArchive::Find()
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Find()
+//--------------------------------------------------------------------------------
+//		Find an asset by id
+//--------------------------------------------------------------------------------
+bool AssetArchive::Find(Type type, uint32 id, Blob& blob) const
+{
+	return Find(type, id, NULL, blob);
+
+}	//End: AssetArchive::Find()
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Find()
+//--------------------------------------------------------------------------------
+//		Find an asset by name
+//--------------------------------------------------------------------------------
+bool AssetArchive::Find(Type type, const std::string& name, Blob& blob) const
+{
+	return Find(type, NameKey(name), &name, blob);
+
+}	//End: AssetArchive::Find()
+
+
+//--------------------------------------------------------------------------------
+//	@	AssetArchive::Write()
+//--------------------------------------------------------------------------------
+//		Pack a list of files into an archive
+//--------------------------------------------------------------------------------
+bool AssetArchive::Write(const std::string& file, const std::vector<Source>& sources)
+{
+	//Read all sources
+	std::vector<std::vector<char> > data(sources.size());
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		std::ifstream in(sources[i].file.c_str(), std::ios::in | std::ios::binary);
+		if (!in)
+		{
+			std::cerr << "@AssetArchive::Write() -> Failed to open: " << sources[i].file << std::endl;
+			return false;
+		}
+		data[i].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	//Build the table of contents in source order, then sort
+	std::vector<Entry> entries(sources.size());
+	std::vector<size_t> order(sources.size());
+	std::string names;
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const Source& s = sources[i];
+		Entry& e = entries[i];
+		e.type = uint32(s.type);
+		e.key = s.name.empty() ? s.id : NameKey(s.name);
+		e.nameOffset = uint32(names.size());
+		e.nameLength = uint32(s.name.size());
+		e.size = data[i].size();
+		names += s.name;
+		order[i] = i;
+	}
+
+	struct ByEntry
+	{
+		const std::vector<Entry>& entries;
+		ByEntry(const std::vector<Entry>& e): entries(e) {}
+		bool operator()(size_t a, size_t b) const {return entries[a] < entries[b];}
+	};
+	std::stable_sort(order.begin(), order.end(), ByEntry(entries));
+
+	//Place data
+	uint64 offset = Aligned(Aligned(Aligned(sizeof(Header)) + entries.size() * sizeof(Entry)) 
+		+ names.size());
+	std::vector<Entry> sorted(entries.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		sorted[i] = entries[order[i]];
+		sorted[i].offset = offset;
+		offset = Aligned(offset + sorted[i].size);
+	}
+
+	//Write
+	std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+	if (!out)
+		return false;
+
+	const char padding[ALIGNMENT] = {0};
+	uint64 written = 0;
+
+	Header header;
+	memcpy(header.magic, MAGIC, 4);
+	header.version = VERSION;
+	header.nEntries = uint32(sorted.size());
+	header.namesSize = uint32(names.size());
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	written += sizeof(Header);
+	out.write(padding, std::streamsize(Aligned(written) - written));
+	written = Aligned(written);
+
+	if (!sorted.empty())
+		out.write(reinterpret_cast<const char*>(&sorted[0]), sorted.size() * sizeof(Entry));
+	written += sorted.size() * sizeof(Entry);
+	out.write(padding, std::streamsize(Aligned(written) - written));
+	written = Aligned(written);
+
+	out.write(names.data(), names.size());
+	written += names.size();
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		out.write(padding, std::streamsize(sorted[i].offset - written));
+		const std::vector<char>& bytes = data[order[i]];
+		if (!bytes.empty())
+			out.write(&bytes[0], bytes.size());
+		written = sorted[i].offset + bytes.size();
+	}
+
+	return out.good();
+
+}	//End: AssetArchive::Write()
@@ -0,0 +1,108 @@
+/*!
+* @file AssetArchive.h
+*
+* Class header: AssetArchive
+*/
+
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include "DgTypes.h"
+#include "MappedFile.h"
+
+/*!
+ * @ingroup utility_io
+ *
+ * @class AssetArchive
+ *
+ * @brief A single file holding many cooked assets.
+ *
+ * The archive starts with a table of contents sorted on (type, key). 
+ * Images are keyed on their numeric id, meshes on a hash of their tag
+ * with the tag stored alongside to resolve collisions. The file is 
+ * memory-mapped when opened, and lookups return a view of an asset's 
+ * bytes inside the mapping. No file is opened and nothing is read into
+ * a buffer per asset: the cookers decode straight from the view into the
+ * engine's own mipmaps and meshes, which is the only copy made.
+ *
+ * At startup the engine opens the archive named by the asset_archive
+ * setting. Assets missing from the archive are loaded from loose files.
+ * Archives are made with --pack, see RUN_PACK().
+ */
+class AssetArchive
+{
+public:
+
+	//! Kinds of asset held in an archive.
+	enum Type
+	{
+		MIPMAP	= 1,	//!< Cooked mipmap chain, keyed on image id
+		MESH	= 2		//!< Cooked mesh, keyed on tag
+	};
+
+	//! A view of an asset inside the archive.
+	struct Blob
+	{
+		const uint8* data;
+		size_t size;
+	};
+
+	//! An asset to pack, read from a file on disk.
+	struct Source
+	{
+		Type type;
+		uint32 id;			//Used if name is empty
+		std::string name;
+		std::string file;
+	};
+
+public:
+
+	AssetArchive() {}
+
+	//! Map an archive and check its table of contents.
+	bool Open(const std::string& file);
+	void Close();
+	bool IsOpen() const {return map.Data() != NULL;}
+
+	//! Find an asset by id.
+	bool Find(Type, uint32 id, Blob&) const;
+
+	//! Find an asset by name.
+	bool Find(Type, const std::string& name, Blob&) const;
+
+	//! Pack files into an archive.
+	static bool Write(const std::string& file, const std::vector<Source>&);
+
+private:
+	struct Entry;
+
+	const Entry* Entries() const;
+	const char* Names() const;
+	uint32 NumEntries() const;
+	bool Find(Type, uint32 key, const std::string* name, Blob&) const;
+
+private:
+	//Data members
+	MappedFile map;
+
+private:
+	//DISALLOW Copy operations
+	AssetArchive(const AssetArchive&);
+	AssetArchive& operator=(const AssetArchive&);
+
+};
+
+
+//--------------------------------------------------------------------------------
+//		Globals
+//--------------------------------------------------------------------------------
+namespace global
+{
+	extern AssetArchive* ASSETS;
+}
+
+#endif
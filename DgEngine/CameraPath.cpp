@@ -0,0 +1,92 @@
+/*!
+* @file CameraPath.cpp
+*
+* Class definitions: CameraPath
+*/
+
+#include "CameraPath.h"
+#include <iostream>
+
+
+//--------------------------------------------------------------------------------
+//	@	operator>>()
+//--------------------------------------------------------------------------------
+//		Read keys from input
+//--------------------------------------------------------------------------------
+DgReader& operator>>(DgReader& in, CameraPath& dest)
+{
+	dest.keys.clear();
+
+	while (IgnoreComments(in))
+	{
+		CameraPath::Key key;
+		if ((in >> key.t >> key.vqs).fail())
+		{
+			std::cerr << "@operator>>(CameraPath) -> Bad read after key " << dest.keys.size() << std::endl;
+			break;
+		}
+
+		if (!dest.keys.empty() && key.t < dest.keys.back().t)
+		{
+			std::cerr << "@operator>>(CameraPath) -> Key " << dest.keys.size() << " is out of order, ignored." << std::endl;
+			continue;
+		}
+
+		dest.keys.push_back(key);
+	}
+
+	return in;
+
+}	//End: operator>>()
+
+
+//--------------------------------------------------------------------------------
+//	@	CameraPath::Duration()
+//--------------------------------------------------------------------------------
+//		Time of the last key
+//--------------------------------------------------------------------------------
+float CameraPath::Duration() const
+{
+	if (keys.empty())
+		return 0.0f;
+
+	return keys.back().t;
+
+}	//End: CameraPath::Duration()
+
+
+//--------------------------------------------------------------------------------
+//	@	CameraPath::At()
+//--------------------------------------------------------------------------------
+//		Placement at time t
+//--------------------------------------------------------------------------------
+VQS CameraPath::At(float t) const
+{
+	if (keys.empty())
+		return VQS();
+
+	if (t <= keys.front().t)
+		return keys.front().vqs;
+
+	if (t >= keys.back().t)
+		return keys.back().vqs;
+
+	//Find the keys either side of t
+	size_t i = 1;
+	while (keys[i].t < t)
+		++i;
+
+	const Key& k0 = keys[i - 1];
+	const Key& k1 = keys[i];
+
+	float span = k1.t - k0.t;
+	float u = (span > 0.0f) ? (t - k0.t) / span : 1.0f;
+
+	Vector4 v = k0.vqs.V() + (k1.vqs.V() - k0.vqs.V()) * u;
+	Quaternion q;
+	Slerp(q, k0.vqs.Q(), k1.vqs.Q(), u);
+	float s = k0.vqs.S() + (k1.vqs.S() - k0.vqs.S()) * u;
+
+	return VQS(v, q, s);
+
+}	//End: CameraPath::At()
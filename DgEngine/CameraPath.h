@@ -0,0 +1,58 @@
+/*!
+* @file CameraPath.h
+*
+* Class header: CameraPath
+*/
+
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <vector>
+#include "Dg_io.h"
+#include "VQS.h"
+
+/*!
+ * @class CameraPath
+ *
+ * @brief A timed sequence of camera placements.
+ *
+ * Read from text, one key per line: the time in seconds followed by a VQS
+ * as read by operator>>(VQS). For example
+ *
+ *     # t  x y z          w x y z               s
+ *     0    0 5 0          1 0 0 0               1
+ *     2.5  -61 5 35       0.98 -0.08 0.15 0     1
+ *
+ * Lines starting with '#' are ignored. Keys must be in order of time.
+ * Overworld writes this form when record_camera_path is set.
+ * Positions are interpolated linearly and rotations spherically. The path
+ * holds its first and last placements outside its time range.
+ */
+class CameraPath
+{
+public:
+
+	//! Read keys from input, replacing those held.
+	friend DgReader& operator>>(DgReader&, CameraPath&);
+
+	bool Empty() const {return keys.empty();}
+
+	//! Time of the last key (s).
+	float Duration() const;
+
+	//! Placement at time t (s).
+	VQS At(float t) const;
+
+private:
+
+	struct Key
+	{
+		float t;
+		VQS vqs;
+	};
+
+	//Data members
+	std::vector<Key> keys;
+};
+
+#endif
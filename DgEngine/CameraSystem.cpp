@@ -15,6 +15,7 @@
 #include "pugixml.hpp"
 #include "Mesh.h"
 #include "Skybox.h"
+#include "Sphere.h"
 
 
 //--------------------------------------------------------------------------------
@@ -230,6 +231,29 @@ void CameraSystem::UpdateVQS(const VQS& vqs)
 }	//End: CameraSystem::UpdateVQS()
 
 
+//--------------------------------------------------------------------------------
+//	@	CameraSystem::ProjectedRadius()
+//--------------------------------------------------------------------------------
+//		Radius of a sphere on the viewport, in pixels. Measured at the depth
+//		of the sphere center along the view direction.
+//--------------------------------------------------------------------------------
+float CameraSystem::ProjectedRadius(const Sphere& s)
+{
+	if (!IsAttached())
+		return 0.0f;
+
+	float half_h = 0.5f * float(view.GetViewport()->h());
+	float depth = Dot(s.Center() - camera.GetPosition(), camera.Direction());
+
+	//Camera is inside or close to the sphere
+	if (depth <= s.Radius() || depth <= camera.NearZ())
+		return half_h;
+
+	return s.Radius() / (depth * camera.Hd2()) * half_h;
+
+}	//End: CameraSystem::ProjectedRadius()
+
+
 //--------------------------------------------------------------------------------
 //	@	CameraSystem::AddObject() 
 //--------------------------------------------------------------------------------
@@ -23,6 +23,7 @@
 class VQS;
 class Mesh;
 class Skybox;
+class Sphere;
 namespace pugi{class xml_node;}
 
 //--------------------------------------------------------------------------------
@@ -84,6 +85,9 @@ public:
 	Point4 CameraOrigin() const { return camera.GetPosition(); }
 	Vector4 CameraDirection() const { return camera.Direction(); }
 
+	//Radius of a world space sphere on the viewport, in pixels
+	float ProjectedRadius(const Sphere&);
+
 private:
 	//Data members
 	Camera camera;
@@ -119,6 +119,33 @@ bool Clipper::ClipPolygon(const Polygon& poly, uint8 planes, Point*& start, uint
 }	//End: Clipper::ClipPolygon()
 
 
+//--------------------------------------------------------------------------------
+//	@	Clipper::IsOutside()
+//--------------------------------------------------------------------------------
+//		Trivial reject. True if all vertices of the polygon are strictly
+//		outside one of the planes. Such a polygon would be culled by
+//		ClipPolygon().
+//--------------------------------------------------------------------------------
+bool Clipper::IsOutside(const Polygon& poly, uint8 planes) const
+{
+	for (uint8 i = 0; i < Frustum::NUMFACES; ++i)
+	{
+		if (!(planes & (1 << i)))
+			continue;
+
+		const Plane4& plane = clipFrustum.GetPlane(i);
+
+		if (plane.Test(poly.p0->position_temp) < 0.0f &&
+			plane.Test(poly.p1->position_temp) < 0.0f &&
+			plane.Test(poly.p2->position_temp) < 0.0f)
+			return true;
+	}
+
+	return false;
+
+}	//End: Clipper::IsOutside()
+
+
 //--------------------------------------------------------------------------------
 //	@	Clipper::ClipNear()
 //--------------------------------------------------------------------------------
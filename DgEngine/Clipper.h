@@ -61,6 +61,9 @@ public:
 	//Process Polygon.
 	bool ClipPolygon(const Polygon&, uint8 planes, Point*& start, uint8& return_size);
 
+	//Is the polygon completely outside one of the planes?
+	bool IsOutside(const Polygon&, uint8 planes) const;
+
 private:
 	//Data members
 
@@ -23,6 +23,12 @@
 #include "Dg_io.h"
 #include "DgTypes.h"
 #include "DgRect.h"
+#include <string.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define COMMONGRAPHICS_SSE2
+#include <emmintrin.h>
+#endif
 
 
 //--------------------------------------------------------------------------------
@@ -144,6 +150,157 @@ bool ClipRect(SDL_Rect& sdlr, int32 w, int32 h)
 }	//End: AdjustRect()
 
 
+//--------------------------------------------------------------------------------
+//		Row kernels for ApplyImage(). Each blends 'count' pixels of a source
+//		row onto a destination row. The SSE2 paths do four pixels at a time,
+//		the scalar loops finish the row and give the same results.
+//--------------------------------------------------------------------------------
+namespace
+{
+	//--------------------------------------------------------------------------------
+	//		Copy all source pixels, except those equal to the color key
+	//--------------------------------------------------------------------------------
+	void ColorKeyRow(uint32* dest, const uint32* src, int32 count)
+	{
+		const uint32 key = Color::COLORKEY.i;
+		int32 i = 0;
+
+#ifdef COMMONGRAPHICS_SSE2
+		const __m128i vkey = _mm_set1_epi32(int(key));
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+
+			//Keep the destination where the source is the key
+			__m128i mask = _mm_cmpeq_epi32(s, vkey);
+			__m128i result = _mm_or_si128(_mm_and_si128(mask, d), _mm_andnot_si128(mask, s));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), result);
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			if (src[i] != key)
+				dest[i] = src[i];
+		}
+	}
+
+
+	//--------------------------------------------------------------------------------
+	//		x / 255, rounded, for x <= 255 * 255
+	//--------------------------------------------------------------------------------
+	inline uint32 Div255(uint32 x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+
+	//--------------------------------------------------------------------------------
+	//		Blend one pixel. With as, ad the source and destination alpha:
+	//			ad' = ad * (255 - as) / 255
+	//			alpha = as + ad'
+	//			color = (cs * as + cd * ad') / 255
+	//--------------------------------------------------------------------------------
+	inline uint32 AlphaPixel(uint32 cs, uint32 cd)
+	{
+		uint32 as = cs >> 24;
+		uint32 ad = Div255((cd >> 24) * (255 - as));
+
+		uint32 r = Div255(((cs >> 16) & 0xFF) * as + ((cd >> 16) & 0xFF) * ad);
+		uint32 g = Div255(((cs >> 8) & 0xFF) * as + ((cd >> 8) & 0xFF) * ad);
+		uint32 b = Div255((cs & 0xFF) * as + (cd & 0xFF) * ad);
+
+		return ((as + ad) << 24) | (r << 16) | (g << 8) | b;
+	}
+
+
+#ifdef COMMONGRAPHICS_SSE2
+	//--------------------------------------------------------------------------------
+	//		Blend two pixels held as 16 bit channels
+	//--------------------------------------------------------------------------------
+	inline __m128i AlphaPixels(__m128i s, __m128i d)
+	{
+		const __m128i max = _mm_set1_epi16(255);
+		const __m128i round = _mm_set1_epi16(128);
+
+		//Alpha lanes of both pixels are set to 255, so the alpha channel 
+		//works out to as + ad'
+		const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+		//Spread each alpha over its pixel
+		__m128i as = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+		__m128i ad = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xFF), 0xFF);
+
+		//ad' = ad * (255 - as) / 255
+		ad = _mm_add_epi16(_mm_mullo_epi16(ad, _mm_sub_epi16(max, as)), round);
+		ad = _mm_srli_epi16(_mm_add_epi16(ad, _mm_srli_epi16(ad, 8)), 8);
+
+		s = _mm_or_si128(s, alphaLanes);
+		d = _mm_or_si128(d, alphaLanes);
+
+		//(cs * as + cd * ad') / 255
+		__m128i x = _mm_add_epi16(_mm_mullo_epi16(s, as), _mm_mullo_epi16(d, ad));
+		x = _mm_add_epi16(x, round);
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+#endif
+
+
+	//--------------------------------------------------------------------------------
+	//		Blend source pixels over the destination by their alpha
+	//--------------------------------------------------------------------------------
+	void AlphaRow(uint32* dest, const uint32* src, int32 count)
+	{
+		int32 i = 0;
+
+#ifdef COMMONGRAPHICS_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(int(0xFF000000));
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+			//Skip clear pixels, copy opaque ones
+			__m128i alpha = _mm_and_si128(s, alphaMask);
+			__m128i clear = _mm_cmpeq_epi32(alpha, zero);
+			if (_mm_movemask_epi8(clear) == 0xFFFF)
+				continue;
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), s);
+				continue;
+			}
+
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+
+			__m128i lo = AlphaPixels(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+			__m128i hi = AlphaPixels(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+
+			//Clear pixels leave the destination as it is
+			__m128i result = _mm_packus_epi16(lo, hi);
+			result = _mm_or_si128(_mm_and_si128(clear, d), _mm_andnot_si128(clear, result));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), result);
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			uint32 cs = src[i];
+			uint32 as = cs >> 24;
+
+			if (as == 0)
+				continue;
+
+			dest[i] = (as == 255) ? cs : AlphaPixel(cs, dest[i]);
+		}
+	}
+}
+
+
 //--------------------------------------------------------------------------------
 //		Blits an image onto another.
 //--------------------------------------------------------------------------------
@@ -191,6 +348,10 @@ void ApplyImage(const Image& src, Image& dest,
 	else
 		src_y_max = src_h;
 
+	int count = src_x_max - src_x_min;
+	if (count <= 0)
+		return;
+
 	switch (type)
 	{
 		//--------------------------------------------------------------------------------
@@ -201,19 +362,8 @@ void ApplyImage(const Image& src, Image& dest,
 			for (int ys = src_y_min, yd = dest_y_min;
 				ys < src_y_max; ys++, yd++)
 			{
-				for (int xs = src_x_min, xd = dest_x_min;
-					xs < src_x_max; xs++, xd++)
-				{
-					//Current pixel
-					uint32 src_p = src_pixels[ys*src_w + xs];
-
-					//Check for colorkey
-					if (src_p == Color::COLORKEY.i)
-						continue;
-
-					dest_pixels[yd*dest_w + xd] = src_p;
-			
-				}
+				ColorKeyRow(&dest_pixels[yd*dest_w + dest_x_min], 
+					&src_pixels[ys*src_w + src_x_min], count);
 			}
 			break;
 		}
@@ -226,41 +376,8 @@ void ApplyImage(const Image& src, Image& dest,
 			for (int ys = src_y_min, yd = dest_y_min;
 				ys < src_y_max; ys++, yd++)
 			{
-
-				uint32 ys_ref = ys * src_w;
-				uint32 yd_ref = yd * dest_w;
-
-				for (int xs = src_x_min, xd = dest_x_min;
-					xs < src_x_max; xs++, xd++)
-				{
-					//Get source pixel
-					uint32 cs(src_pixels[ys_ref + xs]);
-
-					//Get source pixel color
-					uint32 as = ((cs & 0xFF000000) >> 16);
-					uint32 rs = ((cs & 0x00FF0000) >> 16) * as;
-					uint32 gs = ((cs & 0x0000FF00) >> 8) * as;
-					uint32 bs = (cs & 0x000000FF) * as;
-				
-					//Get desination pixel
-					uint32 ind = yd_ref + xd;
-					uint32 cd = dest_pixels[ind];
-
-					//Get destination pixel color
-					uint32 ad = ((cd & 0xFF000000) >> 16);
-					ad = ad * (0xFFFF - as) >> 16;
-					uint32 rd = ((cd & 0x00FF0000) >> 16) * ad;
-					uint32 gd = ((cd & 0x0000FF00) >> 8) * ad;
-					uint32 bd = (cd & 0x000000FF) * ad;
-
-					//Add to desination pixel array
-					dest_pixels[ind] = (((
-						(((ad + as) << 16) & 0xFF000000)
-						| ((rs + rd) & 0x00FF0000))
-						| (((gs + gd) >> 8) & 0x0000FF00))
-						| (((bs + bd) >> 16) & 0x000000FF));
-			
-				}
+				AlphaRow(&dest_pixels[yd*dest_w + dest_x_min], 
+					&src_pixels[ys*src_w + src_x_min], count);
 			}
 			break;
 		}
@@ -273,12 +390,8 @@ void ApplyImage(const Image& src, Image& dest,
 			for (int ys = src_y_min, yd = dest_y_min;
 				ys < src_y_max; ys++, yd++)
 			{
-				for (int xs = src_x_min, xd = dest_x_min;
-					xs < src_x_max; xs++, xd++)
-				{
-					dest_pixels[yd*dest_w + xd] = 
-						src_pixels[ys*src_w + xs];
-				}
+				memcpy(&dest_pixels[yd*dest_w + dest_x_min], 
+					&src_pixels[ys*src_w + src_x_min], count * sizeof(uint32));
 			}
 			break;
 		}
@@ -23,11 +23,13 @@ pugi::xml_node& operator>>(pugi::xml_node& node, Component_ASPECT& dest)
 		}
 		else if (tag == "mesh")
 		{
-			dest.mesh = MESH_MANAGER[std::string(it->child_value())];
+			Mesh_List::Handle h = global::MESH_MANAGER->GetHandle(it->child_value());
+			dest.mesh = (*global::MESH_MANAGER)[h];
 		}
 		else if (tag == "texture")
 		{
-			dest.texture = TEXTURE_MANAGER[std::string(it->child_value())];
+			TextureManager::Handle h = global::TEXTURE_MANAGER->GetHandle(it->child_value());
+			dest.texture = (*global::TEXTURE_MANAGER)[h];
 		}
     }
 
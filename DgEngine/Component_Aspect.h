@@ -6,6 +6,7 @@
 #include "ObjectPair.h"
 #include "Sphere.h"
 #include "OBB.h"
+#include "LightCache.h"
 
 class Mesh;
 class Tetxure;
@@ -18,9 +19,9 @@ class Component_ASPECT : public Component
 {
 public:
     //Constructor
-    Component_ASPECT() : texture(NULL), mesh(NULL), intersects(0) {}
+    Component_ASPECT() : texture(NULL), mesh(NULL), intersects(0), lod(0) {}
 
-    void Clear() { mesh = NULL; texture = NULL; }
+    void Clear() { mesh = NULL; texture = NULL; lod = 0; lightCache.Invalidate(); }
 
 public:
 	//Mesh
@@ -33,10 +34,16 @@ public:
 	//Frustum intersections
 	uint8 intersects;
 
+	//Level of detail drawn last
+	uint8 lod;
+
 	//Texture/materials
 	const Texture* texture;
 	Materials materials;
 
+	//Lit vertex colors from previous frames
+	LightCache lightCache;
+
 };
 
 
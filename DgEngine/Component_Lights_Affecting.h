@@ -4,6 +4,7 @@
 #include "Component.h"
 #include "DgOrderedArray.h"
 #include "DgTypes.h"
+#include "Tuple.h"
 
 namespace pugi{class xml_node;}
 
@@ -14,13 +15,17 @@ namespace pugi{class xml_node;}
 class Component_LIGHTS_AFFECTING : public Component
 {
 public:
-    void Clear() { pointlights.reset(); spotlights.reset(); }
+    Component_LIGHTS_AFFECTING() : residual(0.0f, 0.0f, 0.0f) {}
+    void Clear() { pointlights.reset(); spotlights.reset(); residual.Set(0.0f); }
 
 public:
 	//DATA
 	DgOrderedArray<entityID> pointlights;
 	DgOrderedArray<entityID> spotlights;
 
+	//Approximate light from lights that did not fit in the light budget.
+	Tuple<float> residual;
+
 };
 
 
@@ -14,10 +14,16 @@ namespace pugi{class xml_node;}
 //--------------------------------------------------------------------------------
 class Component_POINTLIGHT : public Component
 {
+public:
+	Component_POINTLIGHT() : stamp(0) {}
+
 public:
 	//DATA
 	ObjectPair<PointLight> light;
 
+	//Incremented whenever light.current changes. Used to invalidate lighting caches.
+	uint32 stamp;
+
 };
 
 //Input
@@ -14,10 +14,16 @@ namespace pugi{class xml_node;}
 //--------------------------------------------------------------------------------
 class Component_SPOTLIGHT : public Component
 {
+public:
+	Component_SPOTLIGHT() : stamp(0) {}
+
 public:
 	//DATA
 	ObjectPair<SpotLight> light;
 
+	//Incremented whenever light.current changes. Used to invalidate lighting caches.
+	uint32 stamp;
+
 };
 
 //Input
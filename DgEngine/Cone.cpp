@@ -74,6 +74,31 @@ Cone& Cone::operator=(const Cone& other)
 }	//End: Cone::operator=()
 
 
+//--------------------------------------------------------------------------------
+//	@	Cone::operator==()
+//--------------------------------------------------------------------------------
+//		Comparison operator
+//--------------------------------------------------------------------------------
+bool Cone::operator==(const Cone& other) const
+{
+	return (origin == other.origin && axis == other.axis &&
+		radius == other.radius && cosTheta == other.cosTheta);
+
+}	//End: Cone::operator==()
+
+
+//--------------------------------------------------------------------------------
+//	@	Cone::operator!=()
+//--------------------------------------------------------------------------------
+//		Comparison operator
+//--------------------------------------------------------------------------------
+bool Cone::operator!=(const Cone& other) const
+{
+	return !(*this == other);
+
+}	//End: Cone::operator!=()
+
+
 //--------------------------------------------------------------------------------
 //	@	Cone::Transform()
 //--------------------------------------------------------------------------------
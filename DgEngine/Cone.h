@@ -37,6 +37,10 @@ public:
 	//Copy operations
 	Cone(const Cone&);
 	Cone& operator= (const Cone&);
+
+	//Comparison
+	bool operator== (const Cone&) const;
+	bool operator!= (const Cone&) const;
 	
 	//Mutators
 	void SetOrigin(const Point4& p)			{origin = p;}
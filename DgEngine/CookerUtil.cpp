@@ -0,0 +1,27 @@
+/*!
+* @file CookerUtil.cpp
+*
+* Function definitions: GetSourceStamp()
+*/
+
+#include "CookerUtil.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+
+
+//--------------------------------------------------------------------------------
+//	@	GetSourceStamp()
+//--------------------------------------------------------------------------------
+//		Size and modification time of a file
+//--------------------------------------------------------------------------------
+bool GetSourceStamp(const std::string& file, SourceStamp& stamp)
+{
+	struct stat info;
+	if (stat(file.c_str(), &info) != 0)
+		return false;
+
+	stamp.size = uint64(info.st_size);
+	stamp.time = uint64(info.st_mtime);
+	return true;
+
+}	//End: GetSourceStamp()
@@ -0,0 +1,37 @@
+/*!
+* @file CookerUtil.h
+*
+* Shared by the cookers: SourceStamp
+*/
+
+#ifndef COOKERUTIL_H
+#define COOKERUTIL_H
+
+#include <string>
+#include <stddef.h>
+#include "DgTypes.h"
+
+/*!
+ * @ingroup utility
+ *
+ * @brief Identifies the version of a source file.
+ *
+ * Cooked files record the stamp of the file they were made from, and are
+ * ignored once it no longer matches.
+ */
+struct SourceStamp
+{
+	uint64 size;
+	uint64 time;
+};
+
+//! Stamp of a file on disk. Returns false if the file does not exist.
+bool GetSourceStamp(const std::string& file, SourceStamp&);
+
+//! Does a recorded size and time match the stamp? A NULL stamp matches anything.
+inline bool StampMatches(const SourceStamp* stamp, uint64 size, uint64 time)
+{
+	return stamp == NULL || (stamp->size == size && stamp->time == time);
+}
+
+#endif
@@ -10,6 +10,8 @@
 #ifndef DGTYPES_H
 #define DGTYPES_H
 
+#include <stdint.h>
+
 /** \addtogroup utility_types
 *  @{
 */
@@ -30,20 +32,11 @@ typedef int                   int32;
 typedef unsigned long long	  uint64;
 typedef long long             int64;
 
-typedef unsigned __int8     uint8_t;
-typedef __int8              int8_t;
-typedef unsigned __int16    uint16_t;
-typedef __int16             int16_t;
-typedef unsigned __int32    uint32_t;
-typedef __int32             int32_t;
-typedef unsigned __int64	  uint64_t;
-typedef __int64             int64_t;
-
 typedef float		            f32;
 typedef double		          f64;
 
 //! @brief Primary ID type for the entity system.
-typedef unsigned __int32	entityID;
+typedef uint32_t	entityID;
 enum ENTITYID{
     ROOT            = 0x00000000,
     ERROR           = 0x06660000,
@@ -57,12 +50,14 @@ enum ENTITYID{
 };
 
 //! @brief ID type for the viewport system.
-typedef unsigned __int32	viewportID;
+typedef uint32_t	viewportID;
 enum VIEWPORTID{
     NONE = 0x0000
 };
 
+#ifndef NULL
 #define NULL 0
+#endif
 /** @}*/
 
 #endif
\ No newline at end of file
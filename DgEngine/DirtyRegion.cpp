@@ -0,0 +1,150 @@
+/*!
+* @file DirtyRegion.cpp
+*
+* Class definitions: DirtyRegion
+*/
+
+#include "DirtyRegion.h"
+
+
+//--------------------------------------------------------------------------------
+//		Box helpers
+//--------------------------------------------------------------------------------
+namespace
+{
+	//Boxes overlap or share an edge
+	template<typename B>
+	bool Touches(const B& a, const B& b)
+	{
+		return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+	}
+
+	template<typename B>
+	B Union(const B& a, const B& b)
+	{
+		B u;
+		u.x0 = (a.x0 < b.x0) ? a.x0 : b.x0;
+		u.y0 = (a.y0 < b.y0) ? a.y0 : b.y0;
+		u.x1 = (a.x1 > b.x1) ? a.x1 : b.x1;
+		u.y1 = (a.y1 > b.y1) ? a.y1 : b.y1;
+		return u;
+	}
+
+	template<typename B>
+	int64 Area(const B& b)
+	{
+		return int64(b.x1 - b.x0) * int64(b.y1 - b.y0);
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	DirtyRegion::SetBounds()
+//--------------------------------------------------------------------------------
+//		Set image size
+//--------------------------------------------------------------------------------
+void DirtyRegion::SetBounds(uint32 w, uint32 h)
+{
+	width = w;
+	height = h;
+	nRects = 0;
+
+}	//End: DirtyRegion::SetBounds()
+
+
+//--------------------------------------------------------------------------------
+//	@	DirtyRegion::Add()
+//--------------------------------------------------------------------------------
+//		Clip and add a rectangle
+//--------------------------------------------------------------------------------
+void DirtyRegion::Add(int32 x0, int32 y0, int32 x1, int32 y1)
+{
+	Box b;
+	b.x0 = (x0 > 0) ? x0 : 0;
+	b.y0 = (y0 > 0) ? y0 : 0;
+	b.x1 = (x1 < int32(width)) ? x1 : int32(width);
+	b.y1 = (y1 < int32(height)) ? y1 : int32(height);
+
+	if (b.x0 >= b.x1 || b.y0 >= b.y1)
+		return;
+
+	Insert(b);
+
+}	//End: DirtyRegion::Add()
+
+
+//--------------------------------------------------------------------------------
+//	@	DirtyRegion::Add()
+//--------------------------------------------------------------------------------
+//		Add all rectangles of another region
+//--------------------------------------------------------------------------------
+void DirtyRegion::Add(const DirtyRegion& other)
+{
+	for (uint32 i = 0; i < other.nRects; ++i)
+	{
+		const Box& b = other.boxes[i];
+		Add(b.x0, b.y0, b.x1, b.y1);
+	}
+
+}	//End: DirtyRegion::Add()
+
+
+//--------------------------------------------------------------------------------
+//	@	DirtyRegion::Insert()
+//--------------------------------------------------------------------------------
+//		Add a clipped box, merging as needed
+//--------------------------------------------------------------------------------
+void DirtyRegion::Insert(Box b)
+{
+	//Absorb every box the new one touches. A merged box can touch
+	//boxes the original did not, so search again after each merge.
+	uint32 i = 0;
+	while (i < nRects)
+	{
+		if (Touches(boxes[i], b))
+		{
+			b = Union(boxes[i], b);
+			boxes[i] = boxes[--nRects];
+			i = 0;
+		}
+		else
+			++i;
+	}
+
+	if (nRects < MAX_RECTS)
+	{
+		boxes[nRects++] = b;
+		return;
+	}
+
+	//Full, merge with the box that grows the least
+	uint32 best = 0;
+	int64 bestGrowth = Area(Union(boxes[0], b)) - Area(boxes[0]);
+	for (i = 1; i < nRects; ++i)
+	{
+		int64 growth = Area(Union(boxes[i], b)) - Area(boxes[i]);
+		if (growth < bestGrowth)
+		{
+			best = i;
+			bestGrowth = growth;
+		}
+	}
+
+	b = Union(boxes[best], b);
+	boxes[best] = boxes[--nRects];
+	Insert(b);
+
+}	//End: DirtyRegion::Insert()
+
+
+//--------------------------------------------------------------------------------
+//	@	DirtyRegion::Get()
+//--------------------------------------------------------------------------------
+//		Rectangle i
+//--------------------------------------------------------------------------------
+DgRect DirtyRegion::Get(uint32 i) const
+{
+	const Box& b = boxes[i];
+	return DgRect(b.x0, b.y0, uint32(b.x1 - b.x0), uint32(b.y1 - b.y0));
+
+}	//End: DirtyRegion::Get()
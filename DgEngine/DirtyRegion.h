@@ -0,0 +1,70 @@
+/*!
+* @file DirtyRegion.h
+*
+* Class header: DirtyRegion
+*/
+
+#ifndef DIRTYREGION_H
+#define DIRTYREGION_H
+
+#include "DgTypes.h"
+#include "DgRect.h"
+
+/*!
+ * @ingroup utility_container
+ *
+ * @class DirtyRegion
+ *
+ * @brief A small set of rectangles covering the changed parts of an image.
+ *
+ * Rectangles are clipped to the bounds of the image. A rectangle which
+ * overlaps or touches one already held is merged with it. Once MAX_RECTS
+ * rectangles are held, a new one is merged with the rectangle it grows
+ * the least. The region may cover more than was changed, never less.
+ */
+class DirtyRegion
+{
+public:
+
+	//! Most rectangles held.
+	enum { MAX_RECTS = 8 };
+
+	DirtyRegion(): nRects(0), width(0), height(0) {}
+
+	//! Set the size of the image. Clears the region.
+	void SetBounds(uint32 w, uint32 h);
+
+	//! Add a rectangle, corners are (x0, y0) inclusive to (x1, y1) exclusive.
+	void Add(int32 x0, int32 y0, int32 x1, int32 y1);
+	void Add(const DgRect& r) {Add(r.x, r.y, r.x + int32(r.w), r.y + int32(r.h));}
+	void Add(const DirtyRegion&);
+
+	//! Cover the whole image.
+	void AddAll() {Add(0, 0, int32(width), int32(height));}
+
+	void Clear() {nRects = 0;}
+	bool IsEmpty() const {return nRects == 0;}
+	uint32 Size() const {return nRects;}
+
+	//! Rectangle i.
+	DgRect Get(uint32 i) const;
+
+private:
+
+	struct Box
+	{
+		int32 x0, y0, x1, y1;
+	};
+
+	//Data members
+	Box boxes[MAX_RECTS];
+	uint32 nRects;
+	uint32 width, height;
+
+	//--------------------------------------------------------------------------------
+	//		Functions
+	//--------------------------------------------------------------------------------
+	void Insert(Box);
+};
+
+#endif
@@ -96,65 +96,94 @@ bool impl::ttf::IsEqual(const std::string tag, uint16 input_size) const
 }	//End: ttf::operator==()
 
 
+//--------------------------------------------------------------------------------
+//	@	ttf::Atlas()
+//--------------------------------------------------------------------------------
+//		Get the glyph atlas, building it if needed
+//--------------------------------------------------------------------------------
+const GlyphAtlas* impl::ttf::Atlas()
+{
+	if (!atlas.IsBuilt() && !atlas.Build(font))
+		return NULL;
+
+	return &atlas;
+
+}	//End: ttf::Atlas()
+
 
 
 
 
 
+
+//--------------------------------------------------------------------------------
+//	@	FontManager::GetHandle()
+//--------------------------------------------------------------------------------
+//		Get the handle of a font. The font is not loaded until used.
+//--------------------------------------------------------------------------------
+impl::FontManager::Handle impl::FontManager::GetHandle(const std::string& str, uint16 val)
+{
+	std::stringstream ss;
+	ss << str << '#' << val;
+	return fonts.Intern(ss.str());
+
+}	//End: FontManager::GetHandle()
+
+
 //--------------------------------------------------------------------------------
 //	@	FontManager::GetFont()
 //--------------------------------------------------------------------------------
 //		Get a font from the list. Attempts to load the font is not
 //		already in the list.
 //--------------------------------------------------------------------------------
-TTF_Font* impl::FontManager::GetFont(std::string str, uint16 val)
+TTF_Font* impl::FontManager::GetFont(Handle h)
 {
-	//fontlist iterator
-	std::list<ttf>::iterator it;
+	ttf* font = fonts.Get(h);
+	if (font != NULL)
+		return font->Font();
 
-	//Loop through list, searching for the font
-	for (it = fontlist.begin(); it != fontlist.end(); ++it)
-	{
-		//If font already exists
-		if (it->IsEqual(str, val))
-			return it->Font();
-	}
+	//Try to load font
+	const std::string& key = fonts.Name(h);
+	size_t split = key.rfind('#');
 
-	//If font not found
+	uint16 val = 0;
+	StringToNumber(val, key.substr(split + 1), std::dec);
 
-	//Try to load font
-	impl::ttf temp(str, val);
-	if (temp.Font() == NULL)
+	font = new ttf(key.substr(0, split), val);
+	if (font->Font() == NULL)
 	{
+		delete font;
 		return NULL;
 	}
 
 	//Add to list and return pointer
-	fontlist.push_back(temp);
-	return fontlist.back().Font();
+	return fonts.Set(h, font)->Font();
 
 }	//End: FontManager::GetFont()
 
 
+//--------------------------------------------------------------------------------
+//	@	FontManager::GetAtlas()
+//--------------------------------------------------------------------------------
+//		Get the glyph atlas of a font. Loads the font if needed.
+//--------------------------------------------------------------------------------
+const GlyphAtlas* impl::FontManager::GetAtlas(Handle h)
+{
+	if (GetFont(h) == NULL)
+		return NULL;
+
+	return fonts.Get(h)->Atlas();
+
+}	//End: FontManager::GetAtlas()
+
+
 //--------------------------------------------------------------------------------
 //	@	FontManager::RemoveFont()
 //--------------------------------------------------------------------------------
 //		Remove a font from the list
 //--------------------------------------------------------------------------------
-void impl::FontManager::RemoveFont(std::string str, uint16 val)
+void impl::FontManager::RemoveFont(const std::string& str, uint16 val)
 {
-	//fontlist iterator
-	std::list<ttf>::iterator it;
-
-	//Loop through list, searching for the font
-	for (it =  fontlist.begin(); it != fontlist.end(); ++it)
-	{
-		//If font exists
-		if (it->IsEqual(str, val))
-		{
-			//Remove font
-			it = fontlist.erase(it);
-		}
-	}
+	fonts.Release(GetHandle(str, val));
 
 }	//End: FontManager::RemoveFont()
\ No newline at end of file
@@ -18,8 +18,10 @@
 #ifndef TTFCONTAINER_H
 #define TTFCONTAINER_H
 
-#include <list>
+#include <string>
 #include "DgTypes.h"
+#include "ResourceRegistry.h"
+#include "GlyphAtlas.h"
 
 typedef struct _TTF_Font TTF_Font;
 
@@ -45,11 +47,15 @@ namespace impl
 		//Return functions
 		TTF_Font* Font() const { return font; }
 
+		//Glyphs of the font, rendered on first use
+		const GlyphAtlas* Atlas();
+
 	private:
 		//Data
 		TTF_Font* font;
 		std::string name;
 		uint16 size;
+		GlyphAtlas atlas;
 
 		//Folt folder
 		static const std::string folder;
@@ -63,22 +69,31 @@ namespace impl
 	class FontManager
 	{
 	public:
+		typedef ResourceRegistry<ttf>::Handle Handle;
+
 		//Constructor/destructor
 		FontManager(){}
 		~FontManager() {}
 
+		//Get the handle of a font, to look it up quickly later
+		Handle GetHandle(const std::string& str, uint16 val);
+
 		//Return a font from the list. Loads fonts as needed.
-		TTF_Font* GetFont(std::string str, uint16 val);
+		TTF_Font* GetFont(Handle);
+		TTF_Font* GetFont(const std::string& str, uint16 val) {return GetFont(GetHandle(str, val));}
+
+		//Return the glyph atlas of a font, NULL if the font failed to load.
+		const GlyphAtlas* GetAtlas(Handle);
 
 		//Remove font by attributes.
-		void RemoveFont(std::string str, uint16 val);
+		void RemoveFont(const std::string& str, uint16 val);
 
 		//Clear all fonts.
-		void Clear() {fontlist.clear();}
+		void Clear() {fonts.ReleaseAll();}
 
 	private:
 		//Data members
-		std::list<ttf> fontlist;
+		ResourceRegistry<ttf> fonts;	//Named by font name and size
 
 		//Disallow copy operations
 		FontManager(const FontManager&);
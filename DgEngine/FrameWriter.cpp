@@ -0,0 +1,247 @@
+/*!
+* @file FrameWriter.cpp
+*
+* Class definitions: FrameWriter
+*/
+
+#include "FrameWriter.h"
+#include "Image.h"
+#include "SDL.h"
+#include "SDL_image.h"
+#include <iostream>
+#include <ctype.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+
+//--------------------------------------------------------------------------------
+//		Helpers
+//--------------------------------------------------------------------------------
+namespace
+{
+	//A file name pattern holds exactly one integer conversion: %d, %5d, %05d
+	bool IsPattern(const std::string& str, bool& valid)
+	{
+		size_t conversions = 0;
+		valid = true;
+		for (size_t i = 0; i < str.size(); ++i)
+		{
+			if (str[i] != '%')
+				continue;
+
+			++conversions;
+			size_t j = i + 1;
+			while (j < str.size() && isdigit(str[j]))
+				++j;
+			if (j == str.size() || str[j] != 'd')
+				valid = false;
+			i = j;
+		}
+
+		valid = valid && conversions <= 1;
+		return conversions > 0;
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::ToFormat()
+//--------------------------------------------------------------------------------
+//		Read a format name
+//--------------------------------------------------------------------------------
+bool FrameWriter::ToFormat(const std::string& str, Format& out)
+{
+	if (str == "ppm")
+		out = PPM;
+	else if (str == "png")
+		out = PNG;
+	else if (str == "raw")
+		out = RAW;
+	else
+		return false;
+
+	return true;
+
+}	//End: FrameWriter::ToFormat()
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::Open()
+//--------------------------------------------------------------------------------
+//		Open a target
+//--------------------------------------------------------------------------------
+bool FrameWriter::Open(const std::string& a_target, Format a_format)
+{
+	Close();
+
+	target = a_target;
+	format = a_format;
+	count = 0;
+
+	bool valid;
+	perFrame = IsPattern(target, valid);
+	if (!valid)
+	{
+		std::cerr << "@FrameWriter::Open() -> Bad file name pattern: " << target << std::endl;
+		return false;
+	}
+
+	if (perFrame)
+		return true;
+
+	if (format == PNG)
+	{
+		std::cerr << "@FrameWriter::Open() -> PNG needs one file per frame, e.g. frame%05d.png" << std::endl;
+		return false;
+	}
+
+	if (target == "-")
+	{
+#ifdef _WIN32
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+		stream = stdout;
+		return true;
+	}
+
+	stream = fopen(target.c_str(), "wb");
+	if (stream == NULL)
+	{
+		std::cerr << "@FrameWriter::Open() -> Failed to open " << target << std::endl;
+		return false;
+	}
+
+	return true;
+
+}	//End: FrameWriter::Open()
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::Close()
+//--------------------------------------------------------------------------------
+//		Close the target
+//--------------------------------------------------------------------------------
+void FrameWriter::Close()
+{
+	if (stream == stdout)
+		fflush(stream);
+	else if (stream)
+		fclose(stream);
+
+	stream = NULL;
+
+}	//End: FrameWriter::Close()
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::Write()
+//--------------------------------------------------------------------------------
+//		Write the next frame
+//--------------------------------------------------------------------------------
+bool FrameWriter::Write(const Image& frame)
+{
+	bool result = false;
+
+	if (perFrame)
+	{
+		char name[1024];
+		snprintf(name, sizeof(name), target.c_str(), int(count));
+
+		if (format == PNG)
+		{
+			result = WritePNG(name, frame);
+		}
+		else
+		{
+			FILE* file = fopen(name, "wb");
+			if (file)
+			{
+				result = WriteTo(file, frame);
+				result = (fclose(file) == 0) && result;
+			}
+		}
+
+		if (!result)
+			std::cerr << "@FrameWriter::Write() -> Failed to write " << name << std::endl;
+	}
+	else if (stream)
+	{
+		result = WriteTo(stream, frame);
+		if (!result)
+			std::cerr << "@FrameWriter::Write() -> Failed to write frame " << count << std::endl;
+	}
+
+	if (result)
+		++count;
+
+	return result;
+
+}	//End: FrameWriter::Write()
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::WriteTo()
+//--------------------------------------------------------------------------------
+//		Write a PPM or raw frame to a stream
+//--------------------------------------------------------------------------------
+bool FrameWriter::WriteTo(FILE* file, const Image& frame)
+{
+	uint32 w = frame.w();
+	uint32 h = frame.h();
+
+	if (format == PPM)
+	{
+		if (fprintf(file, "P6\n%u %u\n255\n", unsigned(w), unsigned(h)) < 0)
+			return false;
+	}
+
+	//Pixels are 0xAARRGGBB
+	uint32 channels = (format == PPM) ? 3 : 4;
+	row.resize(w * channels);
+
+	for (uint32 y = 0; y < h; ++y)
+	{
+		const uint32_t* src = frame.pixels() + y * w;
+		uint8* dest = row.data();
+		for (uint32 x = 0; x < w; ++x)
+		{
+			uint32_t p = src[x];
+			*dest++ = uint8(p >> 16);
+			*dest++ = uint8(p >> 8);
+			*dest++ = uint8(p);
+			if (channels == 4)
+				*dest++ = 0xFF;
+		}
+
+		if (fwrite(row.data(), 1, row.size(), file) != row.size())
+			return false;
+	}
+
+	return true;
+
+}	//End: FrameWriter::WriteTo()
+
+
+//--------------------------------------------------------------------------------
+//	@	FrameWriter::WritePNG()
+//--------------------------------------------------------------------------------
+//		Write a frame to a PNG file
+//--------------------------------------------------------------------------------
+bool FrameWriter::WritePNG(const std::string& file, const Image& frame) const
+{
+	//Wrap the pixels, no alpha mask so the image is saved opaque
+	SDL_Surface* surface = SDL_CreateRGBSurfaceFrom(
+		const_cast<uint32_t*>(frame.pixels()), int(frame.w()), int(frame.h()),
+		32, int(frame.w() * 4), 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+
+	if (surface == NULL)
+		return false;
+
+	bool result = (IMG_SavePNG(surface, file.c_str()) == 0);
+	SDL_FreeSurface(surface);
+	return result;
+
+}	//End: FrameWriter::WritePNG()
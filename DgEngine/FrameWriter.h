@@ -0,0 +1,82 @@
+/*!
+* @file FrameWriter.h
+*
+* Class header: FrameWriter
+*/
+
+#ifndef FRAMEWRITER_H
+#define FRAMEWRITER_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include "DgTypes.h"
+
+class Image;
+
+/*!
+ * @ingroup utility_io
+ *
+ * @class FrameWriter
+ *
+ * @brief Writes a sequence of frames to disk or stdout.
+ *
+ * The target is one of:
+ *
+ *     -                    All frames to stdout, one after another
+ *     frames/f%05d.png     One file per frame, numbered from 0
+ *     frames.raw           All frames to one file, one after another
+ *
+ * Frames are written as binary PPM (P6), PNG, or raw RGBA bytes with no
+ * header. Alpha is written as 255, the window ignores it. PNG can only
+ * be written one file per frame.
+ */
+class FrameWriter
+{
+public:
+
+	enum Format
+	{
+		PPM,
+		PNG,
+		RAW
+	};
+
+	FrameWriter(): format(PPM), stream(NULL), perFrame(false), count(0) {}
+	~FrameWriter() {Close();}
+
+	//! Open a target. Returns false if it cannot be written in the format.
+	bool Open(const std::string& target, Format);
+	void Close();
+
+	//! Write the next frame.
+	bool Write(const Image&);
+
+	//! Frames written.
+	uint32 Count() const {return count;}
+
+	//! Read a format name: ppm, png or raw.
+	static bool ToFormat(const std::string&, Format&);
+
+private:
+	//Data members
+	std::string target;
+	Format format;
+	FILE* stream;			//When frames go to a single stream
+	bool perFrame;
+	uint32 count;
+	std::vector<uint8> row;
+
+	//--------------------------------------------------------------------------------
+	//		Functions
+	//--------------------------------------------------------------------------------
+	bool WriteTo(FILE*, const Image&);
+	bool WritePNG(const std::string& file, const Image&) const;
+
+private:
+	//DISALLOW Copy operations
+	FrameWriter(const FrameWriter&);
+	FrameWriter& operator=(const FrameWriter&);
+};
+
+#endif
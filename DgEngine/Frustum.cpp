@@ -17,6 +17,11 @@
 #include "OBB.h"
 #include "BasisR3.h"
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define FRUSTUM_SSE2
+#include <emmintrin.h>
+#endif
+
 
 //--------------------------------------------------------------------------------
 //	@	Frustum::init()
@@ -30,9 +35,35 @@ void Frustum::init(const Frustum& other)
 
 	origin = other.origin;
 
+	BuildComponents();
+
 }	//End: Frustum::init()
 
 
+//--------------------------------------------------------------------------------
+//	@	Frustum::BuildComponents()
+//--------------------------------------------------------------------------------
+//		Copy plane components into the per-component arrays
+//--------------------------------------------------------------------------------
+void Frustum::BuildComponents()
+{
+	for (uint8 i = 0; i < NUMFACES; ++i)
+	{
+		const Vector4& n = planes[i].Normal();
+		nx[i] = n[0];
+		ny[i] = n[1];
+		nz[i] = n[2];
+		nd[i] = planes[i].Offset();
+	}
+
+	for (uint8 i = NUMFACES; i < NUMLANES; ++i)
+	{
+		nx[i] = ny[i] = nz[i] = nd[i] = 0.0f;
+	}
+
+}	//End: Frustum::BuildComponents()
+
+
 //--------------------------------------------------------------------------------
 //	@	Frustum::Frustum()
 //--------------------------------------------------------------------------------
@@ -90,6 +121,8 @@ void Frustum::Build(const Point4& p0, const BasisR3& basis,
 	planes[4].Set(Cross(OP1,basis.x1()), p0);
 	planes[5].Set(Cross(basis.x1(),OP2), p0);
 
+	BuildComponents();
+
 }	//End: Frustum::Build()
 
 
@@ -153,25 +186,98 @@ bool Frustum::IsInside(const Point4& p) const
 //--------------------------------------------------------------------------------
 uint8 TestFrustumSphere(const Frustum& f, const Sphere& s)
 {
-	uint8 result = Frustum::INSIDE;
-	float dummy;
+	uint8 lastPlane = 0;
+	return TestFrustumSphere(f, s, (1 << Frustum::NUMFACES) - 1, lastPlane);
+
+}	//End: TestFrustumSphere()
+
+
+//--------------------------------------------------------------------------------
+//	@	TestFrustumSphere()
+//--------------------------------------------------------------------------------
+/*		Summary: Test a Sphere against some of the planes of a Frustum
+			--------------------------------------
+		Post:
+		Output bit code as for TestFrustumSphere(). Planes not in the
+		mask are assumed to be fully inside. lastPlane is tested first,
+		and the sphere is rejected at once if it is still outside it.
+		Otherwise all planes are tested together, four at a time where
+		SSE2 is available, and if the sphere is outside, lastPlane is set
+		to a plane that rejects it.
+			--------------------------------------
+		Param<f>:	 input frustum
+		Param<s>:	 input sphere
+		Param<planes>: bit mask of the planes to test
+		Param<lastPlane>: plane which rejected the sphere last time
+*/
+//--------------------------------------------------------------------------------
+uint8 TestFrustumSphere(const Frustum& f, const Sphere& s, 
+						uint8 planes, uint8& lastPlane)
+{
+	const float cx = s.Center()[0];
+	const float cy = s.Center()[1];
+	const float cz = s.Center()[2];
+	const float r = s.Radius();
+
+	//Padding lanes hold no plane
+	planes &= (1 << Frustum::NUMFACES) - 1;
+
+	//The plane which rejected the sphere last time most likely still does
+	if (lastPlane < Frustum::NUMFACES && (planes & (1 << lastPlane)))
+	{
+		float d = f.nx[lastPlane] * cx + f.ny[lastPlane] * cy 
+			+ f.nz[lastPlane] * cz + f.nd[lastPlane];
+		if (d < -r)
+			return Frustum::OUTSIDE;
+	}
+
+	//Bit i set if the sphere is outside / not inside plane i
+	uint32 outside = 0;
+	uint32 straddle = 0;
+
+#ifdef FRUSTUM_SSE2
+
+	const __m128 x = _mm_set1_ps(cx);
+	const __m128 y = _mm_set1_ps(cy);
+	const __m128 z = _mm_set1_ps(cz);
+	const __m128 pr = _mm_set1_ps(r);
+	const __m128 nr = _mm_set1_ps(-r);
+
+	for (uint8 i = 0; i < Frustum::NUMLANES; i += 4)
+	{
+		__m128 d = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f.nx + i), x), _mm_mul_ps(_mm_loadu_ps(f.ny + i), y)),
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f.nz + i), z), _mm_loadu_ps(f.nd + i)));
+
+		outside |= uint32(_mm_movemask_ps(_mm_cmplt_ps(d, nr))) << i;
+		straddle |= uint32(_mm_movemask_ps(_mm_cmple_ps(d, pr))) << i;
+	}
+
+#else
 
 	for (uint8 i = 0; i < Frustum::NUMFACES; ++i)
 	{
-		switch (TestPlaneSphere(s, f.planes[i], dummy))
-		{
-		case 1:
-			{
-				return Frustum::OUTSIDE;
-			}
-		case 2:
-			{
-				result |= (1 << i);
-			}
-		}
+		float d = f.nx[i] * cx + f.ny[i] * cy + f.nz[i] * cz + f.nd[i];
+
+		if (d < -r)
+			outside |= (1 << i);
+		else if (d <= r)
+			straddle |= (1 << i);
 	}
 
-	return result;
+#endif
+
+	outside &= planes;
+	if (outside)
+	{
+		//Remember a rejecting plane to test first next time
+		lastPlane = 0;
+		while (!(outside & (1 << lastPlane)))
+			++lastPlane;
+		return Frustum::OUTSIDE;
+	}
+
+	return uint8(Frustum::INSIDE | (straddle & planes));
 
 }	//End: TestFrustumSphere()
 
@@ -108,7 +108,16 @@ private:
 	Plane4 planes[NUMFACES];			//near, far, top, bottom, left, right.
 	Point4 origin;
 
+	//Planes laid out component by component, so four planes can be
+	//tested against a point at once. Padded to 8 with zero planes.
+	static const uint8 NUMLANES = 8;
+	float nx[NUMLANES];
+	float ny[NUMLANES];
+	float nz[NUMLANES];
+	float nd[NUMLANES];
+
 	void init(const Frustum&);
+	void BuildComponents();
 public:
 	
 	//--------------------------------------------------------------------------------
@@ -116,6 +125,7 @@ public:
 	//--------------------------------------------------------------------------------
 	friend uint8 TestFrustumOBB(const Frustum&, const OBB&);
 	friend uint8 TestFrustumSphere(const Frustum&, const Sphere&);
+	friend uint8 TestFrustumSphere(const Frustum&, const Sphere&, uint8 planes, uint8& lastPlane);
 	friend uint8 TestFrustumOBBQuick(const Frustum&, const OBB&);
 	friend uint8 TestFrustumSphereQuick(const Frustum&, const Sphere&);
 };
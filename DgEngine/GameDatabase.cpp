@@ -1,6 +1,7 @@
 #include "GameDatabase.h"
 #include "Dg_io.h"
 #include "SimpleRNG.h"
+#include "Mesh_List.h"
 
 
 //--------------------------------------------------------------------------------
@@ -55,6 +56,10 @@ void GameDatabase::RemoveEntity(entityID id)
         }
     }
 
+	//Aspect indices change
+	if (Aspects.find(id, ind))
+		aspectTree.SetDirty();
+
 	EntityIDs.erase(id);
   Metas.erase_c(id);
 	Positions.erase_c(id);
@@ -66,6 +71,7 @@ void GameDatabase::RemoveEntity(entityID id)
 	Aspects.erase_c(id);
 	Cameras.erase_c(id);
 	ParticleEmitters.erase_c(id);
+	spatialGrid.Remove(id);
 
 }	//End: GameDatabase::RemoveEntity()
 
@@ -300,6 +306,8 @@ bool GameDatabase::AddAspect(const Component_ASPECT& obj,  entityID id)
 		return false;
 	}
 	
+	aspectTree.SetDirty();
+
 	//Add Entity id if need be
 	int index;
 	if (!EntityIDs.find(id, index))
@@ -512,6 +520,19 @@ entityID GameDatabase::LoadClass(uint32 classID, entityID parent)
 }
 
 
+//--------------------------------------------------------------------------------
+//		Start loading all meshes named in a document in the background
+//--------------------------------------------------------------------------------
+static void PrefetchMeshes(const pugi::xml_document& doc)
+{
+    pugi::xpath_node_set meshes = doc.select_nodes("//mesh");
+    for (pugi::xpath_node_set::const_iterator it = meshes.begin(); it != meshes.end(); ++it)
+    {
+        global::MESH_MANAGER->Prefetch(it->node().child_value());
+    }
+}	//End: PrefetchMeshes()
+
+
 //--------------------------------------------------------------------------------
 //		Builds the database from a xml file
 //--------------------------------------------------------------------------------
@@ -552,6 +573,10 @@ bool GameDatabase::LoadDataFile(const std::string& file)
         return false;
     }
 
+    //Load meshes in parallel while the entities are built
+    PrefetchMeshes(classDocument);
+    PrefetchMeshes(dbDoc);
+
     //iterate through all nodes
     for (pugi::xml_node_iterator it = root.begin(); it != root.end(); ++it)
     {
@@ -574,6 +599,16 @@ bool GameDatabase::LoadDataFile(const std::string& file)
         {
             *it >> ambientLight;
         }
+        else if (tag == "lightBudget")
+        {
+            StringToNumber(lightBudget, it->child_value(), std::dec);
+        }
+        else if (tag == "lightGridCellSize")
+        {
+            float cellSize = 0.0f;
+            if (StringToNumber(cellSize, it->child_value(), std::dec))
+                spatialGrid.SetCellSize(cellSize);
+        }
         else if (tag == "directionalLight")
         {
             uint32 thisID;
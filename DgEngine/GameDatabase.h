@@ -22,6 +22,8 @@
 #include "AmbientLight.h"
 #include "DirectionalLight.h"
 #include "Skybox.h"
+#include "SpatialGrid.h"
+#include "AspectTree.h"
 
 
 /*!
@@ -44,7 +46,7 @@ class GameDatabase
 public:
 
 	//Constructor / destructor
-	GameDatabase() {}
+	GameDatabase() : lightBudget(0) {}
 	~GameDatabase() {}
 
   //! @brief Sets class schema
@@ -100,6 +102,22 @@ public:
 	AmbientLight						ambientLight;
   Dg::map_sl<entityID, DirectionalLight>	directionalLights;
 
+	//Maximum number of point and spot lights applied to an aspect. 
+	//The rest are folded into an ambient term. 0: no limit.
+	uint32								lightBudget;
+
+	//Bounding spheres of lights, kept up to date by SYSTEM_UpdateLights().
+	//The cell size is set by the lightGridCellSize element of a level.
+	SpatialGrid							spatialGrid;
+
+	//Bounding sphere hierarchy over the aspects, refitted by 
+	//SYSTEM_UpdatePhysics().
+	AspectTree							aspectTree;
+
+	//Indices of the aspects in the current camera's frustum, in 
+	//ascending order. Set by SYSTEM_FrustumCull().
+	DgArray<uint32>						visibleAspects;
+
 
 private:    //Data
 
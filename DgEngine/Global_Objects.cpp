@@ -17,6 +17,8 @@
 #include "Mesh_List.h"
 #include "WindowManager.h"
 #include "SettingsParser.h"
+#include "AssetArchive.h"
+#include "ResourceLoader.h"
 
 
 //--------------------------------------------------------------------------------
@@ -29,5 +31,7 @@ namespace global
   Mesh_List       *MESH_MANAGER    = NULL;
   SettingsParser  *SETTINGS        = NULL;
   WindowManager   *WINDOW          = NULL;
+  AssetArchive    *ASSETS          = NULL;
+  ResourceLoader  *LOADER          = NULL;
 }
 
@@ -0,0 +1,259 @@
+/*!
+* @file GlyphAtlas.cpp
+*
+* Class definitions: GlyphAtlas
+*/
+
+#include "GlyphAtlas.h"
+#include "Image.h"
+#include "Color.h"
+#include "SDL_ttf.h"
+#include <string.h>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define GLYPHATLAS_SSE2
+#include <emmintrin.h>
+#endif
+
+
+//--------------------------------------------------------------------------------
+//		Constants
+//--------------------------------------------------------------------------------
+namespace
+{
+	//Width of the atlas. Glyphs are packed left to right in rows.
+	const uint32 ATLAS_WIDTH = 256;
+
+
+	//--------------------------------------------------------------------------------
+	//		Blend a solid color onto a row of pixels, weighted by coverage:
+	//		out = (color * a + dest * (255 - a)) / 255 for each channel.
+	//		The color's alpha is taken as 255.
+	//--------------------------------------------------------------------------------
+	void BlendRow(uint32* dest, const uint8* cov, int32 count, uint32 color)
+	{
+		int32 i = 0;
+
+#ifdef GLYPHATLAS_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i max = _mm_set1_epi16(255);
+		const __m128i round = _mm_set1_epi16(128);
+		const __m128i c = _mm_unpacklo_epi8(_mm_set1_epi32(int(color)), zero);
+
+		//Four pixels at a time
+		for (; i + 4 <= count; i += 4)
+		{
+			uint32 a4;
+			memcpy(&a4, cov + i, 4);
+			if (a4 == 0)
+				continue;
+
+			//Spread each coverage value over the four channels of its pixel
+			__m128i a = _mm_cvtsi32_si128(int(a4));
+			a = _mm_unpacklo_epi8(a, a);
+			a = _mm_unpacklo_epi8(a, a);
+			__m128i aLo = _mm_unpacklo_epi8(a, zero);
+			__m128i aHi = _mm_unpackhi_epi8(a, zero);
+
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+			__m128i dLo = _mm_unpacklo_epi8(d, zero);
+			__m128i dHi = _mm_unpackhi_epi8(d, zero);
+
+			//c * a + d * (255 - a), at most 255 * 255
+			__m128i xLo = _mm_add_epi16(_mm_mullo_epi16(c, aLo),
+				_mm_mullo_epi16(dLo, _mm_sub_epi16(max, aLo)));
+			__m128i xHi = _mm_add_epi16(_mm_mullo_epi16(c, aHi),
+				_mm_mullo_epi16(dHi, _mm_sub_epi16(max, aHi)));
+
+			//Divide by 255, rounded: t = x + 128, (t + (t >> 8)) >> 8
+			xLo = _mm_add_epi16(xLo, round);
+			xHi = _mm_add_epi16(xHi, round);
+			xLo = _mm_srli_epi16(_mm_add_epi16(xLo, _mm_srli_epi16(xLo, 8)), 8);
+			xHi = _mm_srli_epi16(_mm_add_epi16(xHi, _mm_srli_epi16(xHi, 8)), 8);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packus_epi16(xLo, xHi));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			uint32 a = cov[i];
+			if (a == 0)
+				continue;
+
+			uint32 d = dest[i];
+			uint32 result = 0;
+			for (uint32 shift = 0; shift < 32; shift += 8)
+			{
+				uint32 x = ((color >> shift) & 0xFF) * a + ((d >> shift) & 0xFF) * (255 - a) + 128;
+				result |= (((x + (x >> 8)) >> 8) & 0xFF) << shift;
+			}
+			dest[i] = result;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	GlyphAtlas::Build()
+//--------------------------------------------------------------------------------
+//		Render and pack all glyphs
+//--------------------------------------------------------------------------------
+bool GlyphAtlas::Build(TTF_Font* font)
+{
+	if (font == NULL)
+		return false;
+
+	SDL_Color white = {255, 255, 255, 255};
+	std::vector<Image> cells(LAST - FIRST + 1);
+
+	//Render each glyph on its own, trimmed to its visible pixels
+	for (int c = FIRST; c <= LAST; ++c)
+	{
+		Glyph& g = glyphs[c - FIRST];
+		memset(&g, 0, sizeof(Glyph));
+
+		int minx, maxx, miny, maxy, advance;
+		if (TTF_GlyphMetrics(font, Uint16(c), &minx, &maxx, &miny, &maxy, &advance) == 0)
+			g.advance = int16(advance);
+
+		char str[2] = {char(c), 0};
+		SDL_Surface* surface = TTF_RenderText_Blended(font, str, white);
+		Image& cell = cells[c - FIRST];
+		if (surface == NULL || !cell.Set(surface, true))
+			continue;
+
+		//Bounds of the covered pixels
+		int32 x0 = cell.w(), y0 = cell.h(), x1 = 0, y1 = 0;
+		const uint32_t* pixels = cell.pixels();
+		for (int32 y = 0; y < int32(cell.h()); ++y)
+		{
+			for (int32 x = 0; x < int32(cell.w()); ++x)
+			{
+				if ((pixels[y * cell.w() + x] >> 24) == 0)
+					continue;
+
+				if (x < x0) x0 = x;
+				if (y < y0) y0 = y;
+				if (x >= x1) x1 = x + 1;
+				if (y >= y1) y1 = y + 1;
+			}
+		}
+
+		if (x1 <= x0 || y1 <= y0)
+			continue;
+
+		g.xoff = int16(x0);
+		g.yoff = int16(y0);
+		g.w = uint16(x1 - x0);
+		g.h = uint16(y1 - y0);
+	}
+
+	//Pack in rows
+	width = ATLAS_WIDTH;
+	for (uint32 i = 0; i < cells.size(); ++i)
+	{
+		if (glyphs[i].w > width)
+			width = glyphs[i].w;
+	}
+
+	uint32 penX = 0, penY = 0, rowHeight = 0;
+	for (uint32 i = 0; i < cells.size(); ++i)
+	{
+		Glyph& g = glyphs[i];
+		if (penX + g.w > width)
+		{
+			penX = 0;
+			penY += rowHeight;
+			rowHeight = 0;
+		}
+
+		g.x = uint16(penX);
+		g.y = uint16(penY);
+		penX += g.w;
+		if (g.h > rowHeight)
+			rowHeight = g.h;
+	}
+	height = penY + rowHeight;
+
+	//Keep only the coverage
+	coverage.assign(width * height, 0);
+	for (uint32 i = 0; i < cells.size(); ++i)
+	{
+		const Glyph& g = glyphs[i];
+		const uint32_t* pixels = cells[i].pixels();
+		for (uint32 y = 0; y < g.h; ++y)
+		{
+			for (uint32 x = 0; x < g.w; ++x)
+			{
+				uint32_t p = pixels[(g.yoff + y) * cells[i].w() + g.xoff + x];
+				coverage[(g.y + y) * width + g.x + x] = uint8(p >> 24);
+			}
+		}
+	}
+
+	lineHeight = TTF_FontHeight(font);
+	return true;
+
+}	//End: GlyphAtlas::Build()
+
+
+//--------------------------------------------------------------------------------
+//	@	GlyphAtlas::GetGlyph()
+//--------------------------------------------------------------------------------
+//		Glyph of a character, '?' if not held
+//--------------------------------------------------------------------------------
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(char c) const
+{
+	uint8 i = uint8(c);
+	if (i < FIRST || i > LAST)
+		i = '?';
+
+	return glyphs[i - FIRST];
+
+}	//End: GlyphAtlas::GetGlyph()
+
+
+//--------------------------------------------------------------------------------
+//	@	GlyphAtlas::Draw()
+//--------------------------------------------------------------------------------
+//		Blend a glyph onto an image, clipped to the image
+//--------------------------------------------------------------------------------
+void GlyphAtlas::Draw(const Glyph& g, Image& dest, int32 x, int32 y, const Color& clr) const
+{
+	int32 destX = x + g.xoff;
+	int32 destY = y + g.yoff;
+	int32 srcX = g.x;
+	int32 srcY = g.y;
+	int32 w = g.w;
+	int32 h = g.h;
+
+	//Clip
+	if (destX < 0)
+	{
+		srcX -= destX;
+		w += destX;
+		destX = 0;
+	}
+	if (destY < 0)
+	{
+		srcY -= destY;
+		h += destY;
+		destY = 0;
+	}
+	if (destX + w > int32(dest.w()))
+		w = int32(dest.w()) - destX;
+	if (destY + h > int32(dest.h()))
+		h = int32(dest.h()) - destY;
+
+	if (w <= 0 || h <= 0)
+		return;
+
+	uint32 color = clr.i | 0xFF000000;
+	for (int32 j = 0; j < h; ++j)
+	{
+		BlendRow(dest.pixels() + (destY + j) * dest.w() + destX,
+			&coverage[(srcY + j) * width + srcX], w, color);
+	}
+
+}	//End: GlyphAtlas::Draw()
@@ -0,0 +1,76 @@
+/*!
+* @file GlyphAtlas.h
+*
+* Class header: GlyphAtlas
+*/
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <vector>
+#include "DgTypes.h"
+
+typedef struct _TTF_Font TTF_Font;
+class Image;
+struct Color;
+
+/*!
+ * @ingroup graphics_text
+ *
+ * @class GlyphAtlas
+ *
+ * @brief The printable ASCII glyphs of one font and size, rendered once.
+ *
+ * Each glyph is rendered through SDL_ttf when the atlas is built, trimmed
+ * to its visible pixels and packed into a single coverage (alpha) map.
+ * Text is then drawn by blending glyphs out of the atlas in a solid
+ * color, so changing a string needs no font rendering and no new images.
+ *
+ * Characters outside the printable range are drawn as '?'. Kerning is
+ * not applied.
+ */
+class GlyphAtlas
+{
+public:
+
+	//! Where a glyph sits in the atlas, and how to place it.
+	struct Glyph
+	{
+		uint16 x, y;			//In the atlas
+		uint16 w, h;
+		int16 xoff, yoff;		//From the pen position and the top of the line
+		int16 advance;			//Pen movement
+	};
+
+	//! Range of characters held.
+	enum
+	{
+		FIRST = 32,
+		LAST = 126
+	};
+
+	GlyphAtlas(): width(0), height(0), lineHeight(0) {}
+
+	//! Render the glyphs of a font. Returns false if the font is NULL.
+	bool Build(TTF_Font*);
+	bool IsBuilt() const {return lineHeight > 0;}
+
+	//! Glyph of a character.
+	const Glyph& GetGlyph(char c) const;
+
+	int32 LineHeight() const {return lineHeight;}
+
+	//! Blend a glyph onto an image in a solid color. x, y is the pen position
+	//! and the top of the line.
+	void Draw(const Glyph&, Image& dest, int32 x, int32 y, const Color&) const;
+
+private:
+	//Data members
+	std::vector<uint8> coverage;	//width * height
+	uint32 width, height;
+	int32 lineHeight;
+	Glyph glyphs[LAST - FIRST + 1];
+
+};
+
+#endif
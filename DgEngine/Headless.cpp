@@ -0,0 +1,229 @@
+/*!
+* @file Headless.cpp
+*
+* Offscreen rendering
+*/
+
+#include "Utility.h"
+#include "Dg_io.h"
+#include "SettingsParser.h"
+#include "WindowManager.h"
+#include "ImageManager.h"
+#include "ResourceLoader.h"
+#include "ViewportHandler.h"
+#include "Overworld.h"
+#include "CameraPath.h"
+#include "FrameWriter.h"
+#include "Profiler.h"
+#include "MasterPList.h"
+#include <string>
+
+
+//--------------------------------------------------------------------------------
+//	@	WriteBenchmark()
+//--------------------------------------------------------------------------------
+//		Write the benchmark report as JSON
+//--------------------------------------------------------------------------------
+static bool WriteBenchmark(const std::string& file, float fps, uint32 warmup)
+{
+    std::string level("gamma.xml"), path;
+    global::SETTINGS->GetValue("level", level);
+    global::SETTINGS->GetValue("headless_camera_path", path);
+
+    DgFileWriter fileOut;
+    if (file != "-")
+    {
+        fileOut.open(file.c_str());
+        if (!fileOut)
+        {
+            std::cerr << "@WriteBenchmark() -> Failed to open " << file << std::endl;
+            return false;
+        }
+    }
+    DgWriter& out = (file == "-") ? std::cout : fileOut;
+
+    //Names are written as given, without escaping
+    out << "{\n"
+        << "  \"level\": \"" << level << "\",\n"
+        << "  \"camera_path\": \"" << path << "\",\n"
+        << "  \"width\": " << global::WINDOW->w() << ",\n"
+        << "  \"height\": " << global::WINDOW->h() << ",\n"
+        << "  \"fps\": " << fps << ",\n"
+        << "  \"warmup_frames\": " << warmup << ",\n"
+        << "  \"frames\": " << Profiler::Frames() << ",\n";
+    Profiler::WriteJSON(out);
+    out << "\n}\n";
+    out.flush();
+
+    return bool(out);
+
+}	//End: WriteBenchmark()
+
+
+//--------------------------------------------------------------------------------
+//	@	RUN_HEADLESS()
+//--------------------------------------------------------------------------------
+//		Render the overworld offscreen
+//--------------------------------------------------------------------------------
+/*!
+ * The frame loop matches main(), less event handling and the title state.
+ *
+ * If benchmark_output is set, each frame after the first benchmark_warmup
+ * (default 10) is profiled, and frame and stage times are written there as
+ * JSON ("-" for stdout). There must be frames left after the warmup.
+ *
+ * Background loads are finished at the start of every frame, so runs are
+ * repeatable. Their time is counted in the frame after the one which
+ * requested them.
+ */
+int RUN_HEADLESS()
+{
+    std::string str;
+
+    //Game time per frame
+    float fps = 60.0f;
+    if (global::SETTINGS->GetValue("headless_fps", str))
+    {
+        StringToNumber(fps, str, std::dec);
+    }
+    if (fps <= 0.0f)
+    {
+        std::cerr << "@RUN_HEADLESS() -> headless_fps must be above 0." << std::endl;
+        return 1;
+    }
+
+    //Camera path
+    CameraPath path;
+    if (global::SETTINGS->GetValue("headless_camera_path", str) && !LoadFile(str, path))
+    {
+        return 1;
+    }
+
+    //Frames
+    uint32 frames = 1;
+    if (!path.Empty())
+    {
+        frames = uint32(path.Duration() * fps) + 1;
+    }
+    if (global::SETTINGS->GetValue("headless_frames", str))
+    {
+        StringToNumber(frames, str, std::dec);
+    }
+
+    //Output
+    FrameWriter writer;
+    bool writeFrames = false;
+    if (global::SETTINGS->GetValue("headless_output", str))
+    {
+        FrameWriter::Format format = FrameWriter::PPM;
+        std::string formatStr;
+        if (global::SETTINGS->GetValue("headless_format", formatStr) &&
+            !FrameWriter::ToFormat(formatStr, format))
+        {
+            std::cerr << "@RUN_HEADLESS() -> Unknown headless_format: " << formatStr << std::endl;
+            return 1;
+        }
+
+        if (!writer.Open(str, format))
+        {
+            return 1;
+        }
+        writeFrames = true;
+    }
+
+    //Benchmark
+    std::string benchmarkFile;
+    bool benchmark = global::SETTINGS->GetValue("benchmark_output", benchmarkFile);
+    uint32 warmup = 10;
+    if (benchmark && global::SETTINGS->GetValue("benchmark_warmup", str))
+    {
+        StringToNumber(warmup, str, std::dec);
+    }
+    if (benchmark && warmup >= frames)
+    {
+        std::cerr << "@RUN_HEADLESS() -> No frames to profile, " 
+          << frames << " frames with " << warmup << " warmup." << std::endl;
+        return 1;
+    }
+
+    //Raster capture
+    std::string captureFile;
+    bool capture = global::SETTINGS->GetValue("raster_capture", captureFile);
+    uint32 captureFrame = frames - 1;
+    if (capture && global::SETTINGS->GetValue("raster_capture_frame", str))
+    {
+        StringToNumber(captureFrame, str, std::dec);
+    }
+
+    Overworld* world = new Overworld();
+    if (!world->IsLoaded())
+    {
+        delete world;
+        return 1;
+    }
+    world->SetFixedStep(1.0f / fps);
+    if (!path.Empty())
+    {
+        world->SetCameraPath(&path);
+    }
+
+    int result = 0;
+    for (uint32 i = 0; i < frames; ++i)
+    {
+        if (benchmark && i == warmup)
+        {
+            Profiler::Start();
+        }
+        Profiler::BeginFrame();
+
+        if (capture && i == captureFrame)
+        {
+            MasterPList::CaptureNext(captureFile);
+        }
+
+        //Finish every load before the frame, so each run draws the same
+        //resources on the same frames
+        global::LOADER->Wait();
+        global::IMAGE_MANAGER->NewFrame();
+        ViewportHandler::BeginFrame(global::WINDOW);
+
+        world->Logic();
+        world->Render();
+
+        {
+            ProfileScope profile(Profiler::COMPILE);
+            ViewportHandler::Compile(global::WINDOW);
+            ViewportHandler::Reset(true, true);
+        }
+        {
+            ProfileScope profile(Profiler::PRESENT);
+            global::WINDOW->FlipScreen();
+        }
+
+        Profiler::EndFrame();
+
+        if (writeFrames && !writer.Write(global::WINDOW->Frame()))
+        {
+            result = 1;
+            break;
+        }
+    }
+
+    writer.Close();
+    delete world;
+
+    if (benchmark)
+    {
+        Profiler::Stop();
+        if (!WriteBenchmark(benchmarkFile, fps, warmup))
+        {
+            result = 1;
+        }
+    }
+
+    std::cerr << "@RUN_HEADLESS() -> Rendered " << frames << " frames, wrote " 
+      << writer.Count() << "." << std::endl;
+
+    return result;
+
+}	//End: RUN_HEADLESS()
@@ -15,6 +15,8 @@
 #include "Image.h"
 #include "Color.h"
 #include "CommonGraphics.h"
+#include <string.h>
+#include <algorithm>
 
 
 //--------------------------------------------------------------------------------
@@ -25,7 +27,7 @@
 void Image::SetDefault()
 {
 	//Create a one pixel image by default
-	delete[] mPixels;
+	FreePixels();
 	mPixels = new uint32[1];
 	mPixels[0] = 0x00FF00FF;
 	mH = mW = 1;
@@ -58,7 +60,7 @@ bool Image::Set(SDL_Surface* img, bool dealloc)
 	mW = img->w;
 
 	//Copy pixels
-	delete[] mPixels;
+	FreePixels();
 	mPixels = new uint32_t[mH*mW];
 	const uint32_t* input_pixels = (uint32_t*)img->pixels;
 
@@ -76,12 +78,29 @@ bool Image::Set(SDL_Surface* img, bool dealloc)
 }	//End: Image::SetFromSDL_Surface()
 
 
+//--------------------------------------------------------------------------------
+//	@	Image::Set()
+//--------------------------------------------------------------------------------
+//		Copy a block of pixels, rows stored one after another.
+//--------------------------------------------------------------------------------
+void Image::Set(const uint32_t* pixels, uint32 h, uint32 w)
+{
+	FreePixels();
+
+	mH = h;
+	mW = w;
+	mPixels = new uint32_t[mH*mW];
+	memcpy(mPixels, pixels, mH*mW*sizeof(uint32_t));
+
+}	//End: Image::Set()
+
+
 //--------------------------------------------------------------------------------
 //	@	Image::Image()
 //--------------------------------------------------------------------------------
 //		Constructor. Images have a default size of 1x1.
 //--------------------------------------------------------------------------------
-Image::Image(): mPixels(NULL), mH(0), mW(0)
+Image::Image(): mPixels(NULL), mH(0), mW(0), mBorrowed(false)
 {
 	// An Image must be valid. That is it must have at least one pixel.
 	SetDefault();
@@ -108,7 +127,7 @@ bool Image::Load(std::string filename)
 //--------------------------------------------------------------------------------
 Image::~Image()
 {
-	delete[] mPixels;
+	FreePixels();
 
 }	//End: Image::~Image()
 
@@ -118,7 +137,7 @@ Image::~Image()
 //--------------------------------------------------------------------------------
 //		Copy constructor
 //--------------------------------------------------------------------------------
-Image::Image(const Image& other) : mPixels(NULL), mH(other.mH), mW(other.mW)
+Image::Image(const Image& other) : mPixels(NULL), mH(other.mH), mW(other.mW), mBorrowed(false)
 {
 	mPixels = new uint32_t[mH*mW];
 	
@@ -139,7 +158,7 @@ Image& Image::operator=(const Image& other)
 		return *this;
 
 	//Delete old pixel data
-	delete[] mPixels;
+	FreePixels();
 
 	//Assign new data
 	mH = other.mH;
@@ -167,6 +186,54 @@ void Image::Flush(uint32 val)
 }	//End: Image::Flush()
 
 
+//--------------------------------------------------------------------------------
+//	@	Image::Swap()
+//--------------------------------------------------------------------------------
+//		Exchange pixel data and dimensions
+//--------------------------------------------------------------------------------
+void Image::Swap(Image& other)
+{
+	std::swap(mPixels, other.mPixels);
+	std::swap(mH, other.mH);
+	std::swap(mW, other.mW);
+	std::swap(mBorrowed, other.mBorrowed);
+
+}	//End: Image::Swap()
+
+
+//--------------------------------------------------------------------------------
+//	@	Image::Borrow()
+//--------------------------------------------------------------------------------
+//		Use a block of pixels owned elsewhere
+//--------------------------------------------------------------------------------
+void Image::Borrow(uint32_t* pixels, uint32 h, uint32 w)
+{
+	FreePixels();
+
+	mPixels = pixels;
+	mH = h;
+	mW = w;
+	mBorrowed = true;
+
+}	//End: Image::Borrow()
+
+
+//--------------------------------------------------------------------------------
+//	@	Image::FreePixels()
+//--------------------------------------------------------------------------------
+//		Delete the pixel data, unless it is borrowed
+//--------------------------------------------------------------------------------
+void Image::FreePixels()
+{
+	if (!mBorrowed)
+		delete[] mPixels;
+
+	mPixels = NULL;
+	mBorrowed = false;
+
+}	//End: Image::FreePixels()
+
+
 //--------------------------------------------------------------------------------
 //	@	Resize()
 //--------------------------------------------------------------------------------
@@ -292,7 +359,7 @@ void Resize(Image& img, uint32 new_h, uint32 new_w)
 		//Assign data to image
 		img.mH = new_h;
 		img.mW = new_w;
-		delete[] img.mPixels;
+		img.FreePixels();
 		img.mPixels = new_mPixels;
 
 		return;
@@ -396,7 +463,7 @@ void Resize(Image& img, uint32 new_h, uint32 new_w)
 	
 		//Assign data to image
 		img.mW = new_w;
-		delete[] img.mPixels;
+		img.FreePixels();
 		img.mPixels = new_mPixels;
 
 		//If no hieght change, done
@@ -503,7 +570,7 @@ void Resize(Image& img, uint32 new_h, uint32 new_w)
 	
 		//Assign data to image
 		img.mH = new_h;
-		delete[] img.mPixels;
+		img.FreePixels();
 		img.mPixels = new_mPixels;
 		
 		//If no width change, done
@@ -692,7 +759,7 @@ void Resize(Image& img, uint32 new_h, uint32 new_w)
 	}
 
 	//Delete old pixel data
-	delete[] img.mPixels;
+	img.FreePixels();
 
 	//Assign dest pointer to mPixels pointer
 	img.mPixels = dest;
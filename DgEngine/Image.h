@@ -44,6 +44,9 @@ public:
 	//! Set Image from SDL_Surface.
 	bool Set(SDL_Surface*, bool dealloc = true);
 
+	//! Set Image from a block of pixels. The pixels are copied.
+	void Set(const uint32_t* pixels, uint32 h, uint32 w);
+
 	//Return functions
 	uint32 h() const {return mH;}
 	uint32 w() const {return mW;}
@@ -54,6 +57,15 @@ public:
 	//Set all pixels to this value
 	void Flush(uint32_t val = 0);
 
+	//Exchange contents with another image
+	void Swap(Image&);
+
+	//! Use pixels owned elsewhere, rows stored one after another. The
+	//! pixels are not copied and are not deleted by the Image. Setting,
+	//! resizing or assigning to the Image makes it own its pixels again.
+	void Borrow(uint32_t* pixels, uint32 h, uint32 w);
+	bool IsBorrowed() const {return mBorrowed;}
+
 private:
 	//Data members
 
@@ -63,10 +75,14 @@ private:
 	//Dimensions
 	uint32 mH, mW;
 
+	//Pixel data is owned elsewhere
+	bool mBorrowed;
+
 	//--------------------------------------------------------------------------------
 	//		Functions
 	//--------------------------------------------------------------------------------
 	void SetDefault();
+	void FreePixels();
 
 };
 
@@ -13,14 +13,31 @@
 //================================================================================
 
 #include "ImageManager.h"
+#include "MipmapCooker.h"
+#include "AssetArchive.h"
+#include "ResourceLoader.h"
+#include "MappedFile.h"
 #include "Dg_io.h"
 
-#include "pugixml.hpp"
+#include <vector>
+#include <algorithm>
+
+//--------------------------------------------------------------------------------
+//		Mip level streaming
+//--------------------------------------------------------------------------------
+
+//Levels larger than this in either dimension are streamed in when needed
+const uint32 ImageManager::STREAM_SIZE = 128;
+
+//Fine levels unused for this many frames are released, one level at a time
+const uint32 ImageManager::STREAM_RELEASE_FRAMES = 300;
+
 
 //--------------------------------------------------------------------------------
 //	@	ImageManager::ImageManager()
 //--------------------------------------------------------------------------------
-ImageManager::ImageManager() : defaultMipmap(), defaultImage()
+ImageManager::ImageManager() : defaultMipmap(), defaultImage(),
+  budget(0), bytesInUse(0), frame(0)
 {
 }	//End: ImageManage::Imagamanager()
 
@@ -33,6 +50,10 @@ ImageManager::ImageManager(const ImageManager& other) : defaultMipmap(), default
   mipmaps = other.mipmaps;
   images = other.images;
   xmlFile = other.xmlFile;
+  manifest = other.manifest;
+  budget = other.budget;
+  bytesInUse = other.bytesInUse;
+  frame = other.frame;
 }	//End: ImageManage::Imagamanager()
 
 
@@ -47,6 +68,10 @@ ImageManager& ImageManager::operator=(const ImageManager& other)
   mipmaps = other.mipmaps;
   images = other.images;
   xmlFile = other.xmlFile;
+  manifest = other.manifest;
+  budget = other.budget;
+  bytesInUse = other.bytesInUse;
+  frame = other.frame;
 
   return *this;
 }	//End: ImageManage::Imagamanager()
@@ -74,27 +99,33 @@ const Mipmap& ImageManager::GetMipmap(uint32_t id)
   uint32 index;
   if (mipmaps.find(id, index))
   {
-    return *mipmaps[index];
+    mipmaps[index].lastUsed = frame;
+    return *mipmaps[index].ptr;
   }
 
-	//Try to load the mapping file.
-  std::string path = GetFilePathFromXML(id);
+  //Already failed to load
+  if (failed.find(id) != failed.end())
+  {
+    return defaultMipmap;
+  }
 
-  if (path == "")
+  //Load in the background, the default mipmap is used until it is ready
+  if (global::LOADER != NULL)
   {
+    RequestMipmap(id);
     return defaultMipmap;
   }
 
-  //Try to load the mipmap into the list
+  std::string path = GetFilePath(id);
   Mipmap *tempMM = new Mipmap;
-  if (!tempMM->Load(path))
+  if (!LoadMipmap(id, path, *tempMM))
   {
     delete tempMM;
+    failed.insert(id);
     return defaultMipmap;
   }
 
-  Dg::shared_ptr<Mipmap> tempMM_sptr(tempMM);
-  mipmaps.insert(id, tempMM_sptr);
+  AddMipmap(id, path, tempMM);
 
   //Return newly added mipmap
   return *tempMM;
@@ -102,6 +133,368 @@ const Mipmap& ImageManager::GetMipmap(uint32_t id)
 }	//End: ImageManager::operator[]()
 
 
+//--------------------------------------------------------------------------------
+//	@	ImageManager::MipmapExists()
+//--------------------------------------------------------------------------------
+//		Loads the mipmap now if it is not loaded or loading.
+//--------------------------------------------------------------------------------
+bool ImageManager::MipmapExists(uint32_t id)
+{
+  if (id <= FILE_MASK_RES)
+  {
+    return false;
+  }
+
+  //Finish this load only, not everything queued ahead of it
+  RequestMipmap(id);
+  std::map<uint32_t, ResourceLoader::Ticket>::iterator it = pending.find(id);
+  if (it != pending.end())
+  {
+    global::LOADER->Wait(it->second);
+  }
+
+  return &GetMipmap(id) != &defaultMipmap;
+
+}	//End: ImageManager::MipmapExists()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::RequestMipmap()
+//--------------------------------------------------------------------------------
+//		Start loading a mipmap in the background.
+//--------------------------------------------------------------------------------
+void ImageManager::RequestMipmap(uint32_t id)
+{
+  uint32 index;
+  if (global::LOADER == NULL
+    || id <= FILE_MASK_RES
+    || mipmaps.find(id, index)
+    || pending.find(id) != pending.end()
+    || failed.find(id) != failed.end())
+  {
+    return;
+  }
+
+  //The image manifest is read here, only the loading is done by the worker.
+  std::string path = GetFilePath(id);
+  Mipmap* tempMM = new Mipmap;
+  bool* ok = new bool(false);
+
+  pending[id] = global::LOADER->Submit(
+    [=]()
+    {
+      *ok = LoadMipmap(id, path, *tempMM);
+    },
+    [=]()
+    {
+      pending.erase(id);
+
+      if (*ok)
+      {
+        AddMipmap(id, path, tempMM);
+      }
+      else
+      {
+        delete tempMM;
+        failed.insert(id);
+      }
+
+      delete ok;
+    });
+
+}	//End: ImageManager::RequestMipmap()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::LoadMipmap()
+//--------------------------------------------------------------------------------
+//		Load a mipmap from the asset archive, or from its file. 
+//		Touches no ImageManager data, so can be called from a worker.
+//--------------------------------------------------------------------------------
+bool ImageManager::LoadMipmap(uint32_t id, const std::string& path, Mipmap& dest)
+{
+  //Use the asset archive before any loose files. Fine levels of cooked 
+  //chains are streamed in when needed.
+  AssetArchive::Blob blob;
+  if (global::ASSETS != NULL
+    && global::ASSETS->Find(AssetArchive::MIPMAP, id, blob)
+    && MipmapCooker::Read(blob.data, blob.size, NULL, dest, STREAM_SIZE))
+  {
+    return true;
+  }
+
+  return path != "" && dest.Load(path, STREAM_SIZE);
+
+}	//End: ImageManager::LoadMipmap()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::AddMipmap()
+//--------------------------------------------------------------------------------
+//		Take ownership of a loaded mipmap.
+//--------------------------------------------------------------------------------
+void ImageManager::AddMipmap(uint32_t id, const std::string& path, Mipmap* mipmap)
+{
+  Cached<Mipmap> entry;
+  entry.ptr = Dg::shared_ptr<Mipmap>(mipmap);
+  entry.lastUsed = frame;
+  entry.bytes = mipmap->Bytes();
+
+  mipmaps.insert(id, entry);
+  bytesInUse += entry.bytes;
+
+  //Fine levels were left out, remember where to stream them from
+  if (mipmap->GetFirstResident() > 0)
+  {
+    AssetArchive::Blob blob;
+    Stream stream;
+    stream.inArchive = global::ASSETS != NULL
+      && global::ASSETS->Find(AssetArchive::MIPMAP, id, blob);
+    stream.file = path + "." + Mipmap::cooked_extension;
+    stream.coarsest = mipmap->GetFirstResident();
+    stream.lastFineUse = frame;
+    stream.loading = false;
+    streams[id] = stream;
+  }
+
+}	//End: ImageManager::AddMipmap()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::AddImage()
+//--------------------------------------------------------------------------------
+//		Take ownership of a loaded image.
+//--------------------------------------------------------------------------------
+void ImageManager::AddImage(uint32_t id, Image* image)
+{
+  Cached<Image> entry;
+  entry.ptr = Dg::shared_ptr<Image>(image);
+  entry.lastUsed = frame;
+  entry.bytes = size_t(image->h()) * image->pitch();
+
+  images.insert(id, entry);
+  bytesInUse += entry.bytes;
+
+}	//End: ImageManager::AddImage()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::clearMipmaps()
+//--------------------------------------------------------------------------------
+void ImageManager::clearMipmaps()
+{
+  for (uint32 i = 0; i < mipmaps.size(); ++i)
+  {
+    bytesInUse -= mipmaps[i].bytes;
+  }
+
+  mipmaps.clear();
+  failed.clear();
+  streams.clear();
+
+}	//End: ImageManager::clearMipmaps()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::clearImages()
+//--------------------------------------------------------------------------------
+void ImageManager::clearImages()
+{
+  for (uint32 i = 0; i < images.size(); ++i)
+  {
+    bytesInUse -= images[i].bytes;
+  }
+
+  images.clear();
+
+}	//End: ImageManager::clearImages()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::NewFrame()
+//--------------------------------------------------------------------------------
+//		Start a new frame, releasing resources if over budget.
+//--------------------------------------------------------------------------------
+void ImageManager::NewFrame()
+{
+  //Anything used last frame may still be referenced
+  uint32 lastFrame = frame++;
+
+  UpdateStreams();
+
+  if (budget == 0 || bytesInUse <= budget)
+  {
+    return;
+  }
+
+  //Images are not released, as they are handed out to be kept (eg by the
+  //skybox). Mipmaps are looked up by id each time they are drawn.
+  EvictMipmaps(lastFrame);
+
+}	//End: ImageManager::NewFrame()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::EvictMipmaps()
+//--------------------------------------------------------------------------------
+//		Release mipmaps last used before a frame, oldest first, until 
+//		the budget is met.
+//--------------------------------------------------------------------------------
+void ImageManager::EvictMipmaps(uint32 before)
+{
+  //Candidates as (last used, id)
+  std::vector<std::pair<uint32, uint32_t> > candidates;
+  for (uint32 i = 0; i < mipmaps.size(); ++i)
+  {
+    if (mipmaps[i].lastUsed < before)
+    {
+      candidates.push_back(std::make_pair(mipmaps[i].lastUsed, mipmaps.key(i)));
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+
+  for (size_t i = 0; i < candidates.size() && bytesInUse > budget; ++i)
+  {
+    uint32 index;
+    if (!mipmaps.find(candidates[i].second, index))
+    {
+      continue;
+    }
+
+    bytesInUse -= mipmaps[index].bytes;
+    mipmaps.erase(candidates[i].second);
+    streams.erase(candidates[i].second);
+  }
+
+}	//End: ImageManager::EvictMipmaps()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::UpdateStreams()
+//--------------------------------------------------------------------------------
+//		Read last frame's level requests. Stream in finer levels that were
+//		asked for, release fine levels which have gone unused.
+//--------------------------------------------------------------------------------
+void ImageManager::UpdateStreams()
+{
+  std::map<uint32_t, Stream>::iterator it = streams.begin();
+  while (it != streams.end())
+  {
+    uint32 index;
+    if (!mipmaps.find(it->first, index))
+    {
+      it = streams.erase(it);
+      continue;
+    }
+
+    Cached<Mipmap>& entry = mipmaps[index];
+    Stream& stream = it->second;
+
+    uint8 requested = entry.ptr->TakeRequestedLevel();
+    uint8 first = entry.ptr->GetFirstResident();
+
+    if (requested <= first)
+    {
+      stream.lastFineUse = frame;
+    }
+
+    if (stream.loading)
+    {
+      //Wait for the last request
+    }
+    else if (requested < first)
+    {
+      StreamLevels(it->first, requested, first);
+    }
+    else if (first < stream.coarsest && frame - stream.lastFineUse > STREAM_RELEASE_FRAMES)
+    {
+      entry.ptr->ReleaseLevels(first + 1);
+      stream.lastFineUse = frame;
+
+      bytesInUse -= entry.bytes;
+      entry.bytes = entry.ptr->Bytes();
+      bytesInUse += entry.bytes;
+    }
+
+    ++it;
+  }
+
+}	//End: ImageManager::UpdateStreams()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManager::StreamLevels()
+//--------------------------------------------------------------------------------
+//		Load levels [first, end) of a mipmap, in the background if 
+//		possible.
+//--------------------------------------------------------------------------------
+void ImageManager::StreamLevels(uint32_t id, uint8 first, uint8 end)
+{
+  Stream& stream = streams[id];
+  stream.loading = true;
+
+  bool inArchive = stream.inArchive;
+  std::string file = stream.file;
+  std::vector<Image>* levels = new std::vector<Image>;
+  bool* ok = new bool(false);
+
+  ResourceLoader::Function work = [=]()
+  {
+    if (inArchive)
+    {
+      AssetArchive::Blob blob;
+      *ok = global::ASSETS->Find(AssetArchive::MIPMAP, id, blob)
+        && MipmapCooker::ReadLevels(blob.data, blob.size, first, end - first, *levels);
+    }
+    else
+    {
+      MappedFile map;
+      *ok = map.Open(file)
+        && MipmapCooker::ReadLevels(map.Data(), map.Size(), first, end - first, *levels);
+    }
+  };
+
+  ResourceLoader::Function done = [=]()
+  {
+    std::map<uint32_t, Stream>::iterator it = streams.find(id);
+    uint32 index;
+    if (*ok && it != streams.end() && mipmaps.find(id, index))
+    {
+      Cached<Mipmap>& entry = mipmaps[index];
+      entry.ptr->SetResidentLevels(first, *levels);
+
+      bytesInUse -= entry.bytes;
+      entry.bytes = entry.ptr->Bytes();
+      bytesInUse += entry.bytes;
+    }
+
+    //A stream which fails is not retried
+    if (it != streams.end())
+    {
+      if (*ok)
+        it->second.loading = false;
+      else
+        streams.erase(it);
+    }
+
+    delete levels;
+    delete ok;
+  };
+
+  if (global::LOADER != NULL)
+  {
+    global::LOADER->Submit(work, done);
+  }
+  else
+  {
+    work();
+    done();
+  }
+
+}	//End: ImageManager::StreamLevels()
+
+
 //--------------------------------------------------------------------------------
 //	@	ImageManager::GetImage()
 //--------------------------------------------------------------------------------
@@ -124,11 +517,12 @@ const Image& ImageManager::GetImage(uint32_t id)
   uint32 index;
   if (images.find(id, index))
   {
-    return *images[index];
+    images[index].lastUsed = frame;
+    return *images[index].ptr;
   }
 
   //Try to load the mapping file.
-  std::string path = GetFilePathFromXML(id);
+  std::string path = GetFilePath(id);
 
   if (path == "")
   {
@@ -143,8 +537,7 @@ const Image& ImageManager::GetImage(uint32_t id)
     return defaultImage;
   }
 
-  Dg::shared_ptr<Image> tempImg_sptr(tempImg);
-  images.insert(id, tempImg_sptr);
+  AddImage(id, tempImg);
 
   //Return newly added mipmap
   return *tempImg;
@@ -153,54 +546,24 @@ const Image& ImageManager::GetImage(uint32_t id)
 
 
 //--------------------------------------------------------------------------------
-//	@	ImageManager::GetFilenameFromXML()
+//	@	ImageManager::GetFilePath()
 //--------------------------------------------------------------------------------
-std::string ImageManager::GetFilePathFromXML(uint32_t id)
+//		Path of an image from the manifest. Returns "" if not listed.
+//--------------------------------------------------------------------------------
+std::string ImageManager::GetFilePath(uint32_t id)
 {
-  //Try to load the mapping file.
-  pugi::xml_document doc;
-  pugi::xml_parse_result result = doc.load_file(xmlFile.c_str());
-
-  if (!result)
-  {
-    return "";
-  }
-
-  pugi::xml_node root = doc.document_element();
-
-  //Get the path and file components from the id
-  std::stringstream ss;
-  ss << (id & PATH_MASK);
-  std::string pathID(ss.str());
-  ss.str(std::string());
-  ss << (id & FILE_MASK);
-  std::string fileID(ss.str());
-
-  pugi::xml_node pathNode = root.find_child_by_attribute("filePath", "id", pathID.c_str());
-
-  if (!pathNode)
-  {
-    return "";
-  }
-
-  pugi::xml_node fileNode = pathNode.find_child_by_attribute("file", "id", fileID.c_str());
-
-
-  if (!fileNode)
-  {
-    return "";
-  }
-
-  pugi::xml_attribute pathAtt = pathNode.attribute("path");
-  std::string path(pathAtt.as_string());
-  path += std::string(fileNode.child_value());
+  std::string path;
+  manifest.Find(id, path);
   return path;
 
-}	//End: ImageManager::GetFilenameFromXML()
+}	//End: ImageManager::GetFilePath()
 
 
 //--------------------------------------------------------------------------------
-//		@GameDtabase::SetDataFile()
+//		@ImageManager::SetDataFile()
+//--------------------------------------------------------------------------------
+//		Index the manifest. The manifest is only validated and parsed if
+//		it has changed since its index was cached.
 //--------------------------------------------------------------------------------
 bool ImageManager::SetDataFile(const std::string& path)
 {
@@ -209,18 +572,33 @@ bool ImageManager::SetDataFile(const std::string& path)
     return true;
   }
 
-  XMLValidator fileValidator;
-  if (!fileValidator.SetSchema(s_schemaPath))
+  ImageManifest index;
+  if (!index.ReadCache(path))
   {
-    return false;
-  }
+    XMLValidator fileValidator;
+    if (!fileValidator.SetSchema(s_schemaPath))
+    {
+      return false;
+    }
 
-  //Does class file conform to the schema?
-  if (!fileValidator.ValidateXML(path))
-  {
-    return false;
+    //Does class file conform to the schema?
+    if (!fileValidator.ValidateXML(path))
+    {
+      return false;
+    }
+
+    if (!index.Parse(path))
+    {
+      return false;
+    }
+
+    if (!index.WriteCache(path))
+    {
+      std::cerr << "@ImageManager::SetDataFile() -> Could not write index of " << path << std::endl;
+    }
   }
 
+  manifest.Swap(index);
   xmlFile = path;
 
   return true;
@@ -16,11 +16,15 @@
 #define ImageManager_H
 
 #include <string>
+#include <set>
+#include <map>
 #include "Mipmap.h"
 #include "Image.h"
 #include "dg_shared_ptr.h"
 #include "dg_map.h"
 #include "XMLValidator.h"
+#include "ImageManifest.h"
+#include "ResourceLoader.h"
 
 
 //--------------------------------------------------------------------------------
@@ -49,28 +53,77 @@ public:
   ImageManager(const ImageManager&);
   ImageManager& operator=(const ImageManager&);
 
-	//Accessors
+	//Accessors. If a resource loader is running, a mipmap not yet loaded is
+	//requested and the default mipmap returned until it is ready.
 	const Mipmap& GetMipmap(uint32_t id);
 	const Image& GetImage(uint32_t id);
 
   //Loads the resource into memory if exists.
-  bool MipmapExists(uint32_t a_id) { return (&GetMipmap(a_id) != &defaultMipmap); }
+  bool MipmapExists(uint32_t a_id);
   bool ImageExists(uint32_t a_id) { return (&GetImage(a_id) != &defaultImage); }
 
+  //Start loading a mipmap in the background, eg to prefetch a level.
+  void RequestMipmap(uint32_t id);
+
 	//Manipulators
-	void clearAll() {mipmaps.clear(); images.clear();}
-	void clearMipmaps() {mipmaps.clear();}
-	void clearImages() {images.clear();}
+	void clearAll() {clearMipmaps(); clearImages();}
+	void clearMipmaps();
+	void clearImages();
+
+  //Memory budget for loaded mipmaps and images, in bytes. 0 for no limit.
+  void SetBudget(size_t bytes) {budget = bytes;}
+  size_t GetBudget() const {return budget;}
+  size_t BytesInUse() const {return bytesInUse;}
+
+  //Call at the start of each frame. Streams in mipmap levels the rasterizer
+  //asked for last frame and releases fine levels which have gone unused.
+  //Then, mipmaps not used in the last frame are released, least recently 
+  //used first, until the budget is met. Released mipmaps are loaded again 
+  //when next requested.
+  void NewFrame();
 
   //Set the path to the (XML) file which maps image file names to IDs.
+  //The file is read once into an index.
   bool SetDataFile(const std::string& path);
 
+  //The manifest loaded at startup
+  const static std::string s_manifestPath;
+
+private:
+  //A loaded resource and when it was last used
+  template<typename T>
+  struct Cached
+  {
+    Dg::shared_ptr<T> ptr;
+    uint32 lastUsed;              //Frame
+    size_t bytes;
+  };
+
+  //Where to stream the fine levels of a mipmap from
+  struct Stream
+  {
+    bool inArchive;
+    std::string file;             //Cooked file, if not in the archive
+    uint8 coarsest;               //Levels from here on are never released
+    uint32 lastFineUse;           //Frame the finest resident level was asked for
+    bool loading;
+  };
+
 private:
   //Data members
-	Dg::map<uint32_t, Dg::shared_ptr<Mipmap>> mipmaps;	//Container for all mipmaps
-  Dg::map<uint32_t, Dg::shared_ptr<Image>> images;	//Container for all Images
+	Dg::map<uint32_t, Cached<Mipmap>> mipmaps;	//Container for all mipmaps
+  Dg::map<uint32_t, Cached<Image>> images;	//Container for all Images
+
+  std::map<uint32_t, ResourceLoader::Ticket> pending; //Mipmaps being loaded in the background
+  std::set<uint32_t> failed;        //Mipmaps which could not be loaded
+  std::map<uint32_t, Stream> streams; //Mipmaps with levels to stream
 
   std::string xmlFile;              //The xml file that maps image files to ids.
+  ImageManifest manifest;           //Index of xmlFile
+
+  size_t budget;                    //Bytes, 0 for no limit
+  size_t bytesInUse;
+  uint32 frame;
 
 	//Defaults
 	const Mipmap defaultMipmap;
@@ -78,10 +131,18 @@ private:
 
 private:
   //Functions
-  std::string GetFilePathFromXML(uint32_t id);
+  std::string GetFilePath(uint32_t id);
+  static bool LoadMipmap(uint32_t id, const std::string& path, Mipmap& dest);
+  void AddMipmap(uint32_t id, const std::string& path, Mipmap*);
+  void AddImage(uint32_t id, Image*);
+  void EvictMipmaps(uint32 before);
+  void UpdateStreams();
+  void StreamLevels(uint32_t id, uint8 first, uint8 end);
 
 private:
   const static std::string s_schemaPath;
+  const static uint32 STREAM_SIZE;
+  const static uint32 STREAM_RELEASE_FRAMES;
 };
 
 //--------------------------------------------------------------------------------
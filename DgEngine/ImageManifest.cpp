@@ -0,0 +1,274 @@
+/*!
+* @file ImageManifest.cpp
+*
+* Class definitions: ImageManifest
+*/
+
+#include "ImageManifest.h"
+#include "ImageManager.h"
+#include "MappedFile.h"
+#include "Dg_io.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		Cache layout. All records are 4 byte aligned.
+//
+//		Header
+//		Entries			Entry[nEntries]
+//		Text			textLength chars, the paths
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char MAGIC[4] = {'D', 'G', 'I', 'X'};
+	const uint32 VERSION = 1;
+
+	//Bits of the image id the folder id is shifted by
+	const uint32 PATH_SHIFT = 20;
+
+	struct Header
+	{
+		char magic[4];
+		uint32 version;
+		uint64 manifestHash;
+		uint32 nEntries;
+		uint32 textLength;
+	};
+
+	struct Entry
+	{
+		uint32 id;
+		uint32 offset;
+		uint32 length;
+	};
+
+	//FNV-1a, identifies the manifest a cache was made from
+	uint64 Hash(const uint8* data, size_t size)
+	{
+		uint64 hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	//Hash a manifest on disk
+	bool HashFile(const std::string& file, uint64& hash)
+	{
+		MappedFile map;
+		if (!map.Open(file))
+			return false;
+
+		hash = Hash(map.Data(), map.Size());
+		return true;
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::ReadCache()
+//--------------------------------------------------------------------------------
+//		Load the index from the cache of a manifest
+//--------------------------------------------------------------------------------
+bool ImageManifest::ReadCache(const std::string& file)
+{
+	uint64 manifestHash;
+	if (!HashFile(file, manifestHash))
+		return false;
+
+	MappedFile map;
+	if (!map.Open(file + "." + cache_extension) || map.Size() < sizeof(Header))
+		return false;
+
+	const Header* header = reinterpret_cast<const Header*>(map.Data());
+
+	//Check header
+	if (memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION
+		|| header->manifestHash != manifestHash)
+		return false;
+
+	//Check size
+	size_t expected = sizeof(Header) + size_t(header->nEntries) * sizeof(Entry)
+		+ header->textLength;
+
+	if (map.Size() < expected)
+		return false;
+
+	const Entry* entries = reinterpret_cast<const Entry*>(map.Data() + sizeof(Header));
+	const char* text = reinterpret_cast<const char*>(entries + header->nEntries);
+
+	std::unordered_map<uint32, std::string> index;
+	index.reserve(header->nEntries);
+	for (uint32 i = 0; i < header->nEntries; ++i)
+	{
+		const Entry& e = entries[i];
+		if (size_t(e.offset) + e.length > header->textLength)
+			return false;
+
+		index[e.id].assign(text + e.offset, e.length);
+	}
+
+	paths.swap(index);
+	hash = manifestHash;
+	return true;
+
+}	//End: ImageManifest::ReadCache()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::Parse()
+//--------------------------------------------------------------------------------
+//		Build the index from a manifest
+//--------------------------------------------------------------------------------
+bool ImageManifest::Parse(const std::string& file)
+{
+	MappedFile map;
+	if (!map.Open(file))
+		return false;
+
+	pugi::xml_document doc;
+	if (!doc.load_buffer(map.Data(), map.Size()))
+	{
+		std::cerr << "@ImageManifest::Parse() -> Failed to parse " << file << std::endl;
+		return false;
+	}
+
+	std::unordered_map<uint32, std::string> index;
+
+	pugi::xml_node root = doc.document_element();
+	for (pugi::xml_node pathNode = root.child("filePath"); pathNode;
+		pathNode = pathNode.next_sibling("filePath"))
+	{
+		uint32 pathID;
+		if (!StringToNumber(pathID, pathNode.attribute("id").value(), std::hex))
+		{
+			std::cerr << "@ImageManifest::Parse() -> Bad filePath id." << std::endl;
+			continue;
+		}
+
+		std::string folder(pathNode.attribute("path").value());
+		pathID = (pathID << PATH_SHIFT) & ImageManager::PATH_MASK;
+
+		for (pugi::xml_node fileNode = pathNode.child("file"); fileNode;
+			fileNode = fileNode.next_sibling("file"))
+		{
+			uint32 fileID;
+			if (!StringToNumber(fileID, fileNode.attribute("id").value(), std::hex))
+			{
+				std::cerr << "@ImageManifest::Parse() -> Bad file id in " << folder << std::endl;
+				continue;
+			}
+
+			index[pathID | (fileID & ImageManager::FILE_MASK)] = folder + fileNode.child_value();
+		}
+	}
+
+	paths.swap(index);
+	hash = Hash(map.Data(), map.Size());
+	return true;
+
+}	//End: ImageManifest::Parse()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::WriteCache()
+//--------------------------------------------------------------------------------
+//		Save the index next to its manifest
+//--------------------------------------------------------------------------------
+bool ImageManifest::WriteCache(const std::string& file) const
+{
+	std::vector<Entry> entries;
+	entries.reserve(paths.size());
+
+	std::string text;
+	std::unordered_map<uint32, std::string>::const_iterator it = paths.begin();
+	for (; it != paths.end(); ++it)
+	{
+		Entry e;
+		e.id = it->first;
+		e.offset = uint32(text.size());
+		e.length = uint32(it->second.size());
+		entries.push_back(e);
+		text += it->second;
+	}
+
+	std::ofstream out((file + "." + cache_extension).c_str(), std::ios::out | std::ios::binary);
+	if (!out)
+		return false;
+
+	Header header;
+	memcpy(header.magic, MAGIC, 4);
+	header.version = VERSION;
+	header.manifestHash = hash;
+	header.nEntries = uint32(entries.size());
+	header.textLength = uint32(text.size());
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	if (!entries.empty())
+		out.write(reinterpret_cast<const char*>(&entries[0]), entries.size() * sizeof(Entry));
+
+	out.write(text.data(), text.size());
+	return out.good();
+
+}	//End: ImageManifest::WriteCache()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::Find()
+//--------------------------------------------------------------------------------
+//		Look up the path of an image
+//--------------------------------------------------------------------------------
+bool ImageManifest::Find(uint32 id, std::string& path) const
+{
+	std::unordered_map<uint32, std::string>::const_iterator it = paths.find(id);
+	if (it == paths.end())
+		return false;
+
+	path = it->second;
+	return true;
+
+}	//End: ImageManifest::Find()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::GetIDs()
+//--------------------------------------------------------------------------------
+void ImageManifest::GetIDs(std::vector<uint32>& out) const
+{
+	out.clear();
+	out.reserve(paths.size());
+
+	std::unordered_map<uint32, std::string>::const_iterator it = paths.begin();
+	for (; it != paths.end(); ++it)
+		out.push_back(it->first);
+
+	std::sort(out.begin(), out.end());
+
+}	//End: ImageManifest::GetIDs()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::Clear()
+//--------------------------------------------------------------------------------
+void ImageManifest::Clear()
+{
+	paths.clear();
+	hash = 0;
+
+}	//End: ImageManifest::Clear()
+
+
+//--------------------------------------------------------------------------------
+//	@	ImageManifest::Swap()
+//--------------------------------------------------------------------------------
+void ImageManifest::Swap(ImageManifest& other)
+{
+	paths.swap(other.paths);
+	std::swap(hash, other.hash);
+
+}	//End: ImageManifest::Swap()
@@ -0,0 +1,69 @@
+/*!
+* @file ImageManifest.h
+*
+* Class header: ImageManifest
+*/
+
+#ifndef IMAGEMANIFEST_H
+#define IMAGEMANIFEST_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stddef.h>
+#include "DgTypes.h"
+
+/*!
+ * @ingroup graphics
+ *
+ * @class ImageManifest
+ *
+ * @brief Maps image ids to file paths.
+ *
+ * The manifest (Images.xml) lists image files by folder:
+ *
+ *     <filePath path="./images/" id="100">
+ *       <file id="10000">blank.png</file>
+ *
+ * Both ids are hex. The folder id forms the top 12 bits of an image id,
+ * the file id the lower 20 bits. The manifest is parsed once into a hash
+ * index. The index is also written to a binary cache next to the manifest,
+ * holding a hash of the manifest bytes. If the manifest has not changed,
+ * the cache is read instead and the XML is not parsed at all.
+ */
+class ImageManifest
+{
+public:
+
+	ImageManifest(): hash(0) {}
+
+	//! Read the cached index of a manifest. Fails if there is no cache or
+	//! the manifest has changed since it was written.
+	bool ReadCache(const std::string& file);
+
+	//! Parse a manifest.
+	bool Parse(const std::string& file);
+
+	//! Write the cached index of the last manifest read or parsed.
+	bool WriteCache(const std::string& file) const;
+
+	//! Find the path of an image. Returns false if the id is not listed.
+	bool Find(uint32 id, std::string& path) const;
+
+	size_t Size() const {return paths.size();}
+
+	//! Every image id listed, in increasing order.
+	void GetIDs(std::vector<uint32>&) const;
+	void Clear();
+	void Swap(ImageManifest&);
+
+	//! Appended to the manifest file name to name the cache.
+	static const std::string cache_extension;
+
+private:
+	//Data members
+	std::unordered_map<uint32, std::string> paths;
+	uint64 hash;			//Of the manifest bytes
+};
+
+#endif
@@ -3,14 +3,16 @@
 #include "Dg_io.h"
 #include "Systems.h"
 #include "WindowManager.h"
+#include "SettingsParser.h"
 
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
-Overworld::Overworld()
+Overworld::Overworld(): fixedStep(0.0f), steps(0), cameraPath(NULL), recordTime(0.0f),
+	loaded(false)
 {
 	//Load from input file
-	Init();
+	loaded = Init();
 
 	//Load the help text
 	helpBox.Load("help");
@@ -21,7 +23,18 @@ Overworld::Overworld()
 	timer.Start();
 
 	//Grab mouse
-	mousecontrol.Grab(WINDOW);
+	if (!WINDOW->IsHeadless())
+		mousecontrol.Grab(WINDOW);
+
+	//Record the player's path for replay
+	std::string recordFile;
+	if (global::SETTINGS->GetValue("record_camera_path", recordFile))
+	{
+		pathRecord.open(recordFile.c_str());
+		if (!pathRecord)
+			std::cerr << "@Overworld::Overworld() -> Failed to open " << recordFile << std::endl;
+		pathRecord.precision(9);
+	}
 	
 	fps.SetPosition(10, 10);
 
@@ -34,7 +47,8 @@ Overworld::Overworld()
 Overworld::~Overworld()
 {
 	//Reset mouse
-	mousecontrol.Release(WINDOW);
+	if (!WINDOW->IsHeadless())
+		mousecontrol.Release(WINDOW);
 }
 
 
@@ -43,7 +57,15 @@ Overworld::~Overworld()
 //--------------------------------------------------------------------------------
 bool Overworld::Init()
 {
-    gameData.LoadDataFile("gamma.xml");
+	//Level, gamma.xml unless set
+	std::string level("gamma.xml");
+	global::SETTINGS->GetValue("level", level);
+
+	if (!gameData.LoadDataFile(level))
+	{
+		std::cerr << "@Overworld::Init() -> Failed to load level: " << level << std::endl;
+		return false;
+	}
 
 	//--------------------------------------------------------------------------------
 	//		Run post processing system
@@ -52,5 +74,6 @@ bool Overworld::Init()
 	
 	SYSTEM_PostProcess(gameData);
 	
+	return true;
 
 }	//End: operator>>()
\ No newline at end of file
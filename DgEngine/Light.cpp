@@ -45,6 +45,19 @@ Light& Light::operator=(const Light& other)
 }	//End: Light::operator=()
 
 
+//--------------------------------------------------------------------------------
+//		Comparison
+//--------------------------------------------------------------------------------
+bool Light::operator==(const Light& other) const
+{
+	return (intensity == other.intensity &&
+			color[0] == other.color[0] &&
+			color[1] == other.color[1] &&
+			color[2] == other.color[2]);
+
+}	//End: Light::operator==()
+
+
 //--------------------------------------------------------------------------------
 //		Set intensity
 //--------------------------------------------------------------------------------
@@ -46,6 +46,10 @@ public:
 		color(light.color){}
 	Light& operator= (const Light&);
 
+	//! Compares color and intensity.
+	bool operator== (const Light&) const;
+	bool operator!= (const Light& other) const {return !(*this == other);}
+
 	//Manipulators
 
 	//! Set a RGB color
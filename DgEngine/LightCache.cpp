@@ -0,0 +1,156 @@
+/*!
+* @file LightCache.cpp
+*
+* Class definitions: LightCache
+*/
+
+#include "LightCache.h"
+#include "Mesh.h"
+#include "Vertex.h"
+
+
+//--------------------------------------------------------------------------------
+//	@	LightCache::LightCache()
+//--------------------------------------------------------------------------------
+//		Copy constructor
+//--------------------------------------------------------------------------------
+LightCache::LightCache(const LightCache& other): isValid(other.isValid),
+	mesh(other.mesh), T_WLD_OBJ(other.T_WLD_OBJ), key(other.key),
+	colors(other.colors), isLit(other.isLit)
+{
+}	//End: LightCache::LightCache()
+
+
+//--------------------------------------------------------------------------------
+//	@	LightCache::operator=()
+//--------------------------------------------------------------------------------
+//		Assignment
+//--------------------------------------------------------------------------------
+LightCache& LightCache::operator=(const LightCache& other)
+{
+	if (this == &other)
+		return *this;
+
+	isValid = other.isValid;
+	mesh = other.mesh;
+	T_WLD_OBJ = other.T_WLD_OBJ;
+	key = other.key;
+	colors = other.colors;
+	isLit = other.isLit;
+
+	return *this;
+
+}	//End: LightCache::operator=()
+
+
+//--------------------------------------------------------------------------------
+//	@	LightCache::Validate()
+//--------------------------------------------------------------------------------
+//		Compare the input key against the stored key
+//--------------------------------------------------------------------------------
+void LightCache::Validate(const Mesh& a_mesh, const VQS& a_T_WLD_OBJ,
+						  const DgArray<uint32>& a_key)
+{
+	if (isValid && mesh == &a_mesh && key.size() == a_key.size())
+	{
+		uint32 i = 0;
+		for (; i < key.size(); ++i)
+		{
+			if (key[i] != a_key[i])
+				break;
+		}
+
+		if (i == key.size() && T_WLD_OBJ == a_T_WLD_OBJ)
+			return;
+	}
+
+	//Flag all vertices as unlit
+	uint32 nVertices = a_mesh.GetVertices().size();
+
+	//Only reallocate if the mesh has grown
+	if (colors.max_size() < nVertices)
+	{
+		colors.resize(nVertices);
+		isLit.resize(nVertices);
+	}
+
+	colors.clear();
+	isLit.clear();
+	for (uint32 i = 0; i < nVertices; ++i)
+	{
+		colors.push_back(Tuple<float>(0.0f, 0.0f, 0.0f));
+		isLit.push_back(false);
+	}
+
+	mesh = &a_mesh;
+	T_WLD_OBJ = a_T_WLD_OBJ;
+	key = a_key;
+	isValid = true;
+
+}	//End: LightCache::Validate()
+
+
+//--------------------------------------------------------------------------------
+//	@	LightCache::Fetch()
+//--------------------------------------------------------------------------------
+//		Copy cached vertex colors to a mesh
+//--------------------------------------------------------------------------------
+uint32 LightCache::Fetch(Mesh& a_mesh)
+{
+	DgArray<Vertex>& VList = a_mesh.GetVertices();
+	uint32 nUnlit = 0;
+
+	fetched.clear();
+
+	if (isLit.size() != VList.size())
+		return 0;
+
+	for (uint32 i = 0; i < VList.size(); ++i)
+	{
+		if (VList[i].state == 'x')
+			continue;
+
+		if (!isLit[i])
+		{
+			++nUnlit;
+			continue;
+		}
+
+		VList[i].clr = colors[i];
+		VList[i].state = 'x';
+		fetched.push_back(i);
+	}
+
+	return nUnlit;
+
+}	//End: LightCache::Fetch()
+
+
+//--------------------------------------------------------------------------------
+//	@	LightCache::Store()
+//--------------------------------------------------------------------------------
+//		Copy vertex colors from a mesh
+//--------------------------------------------------------------------------------
+void LightCache::Store(Mesh& a_mesh)
+{
+	DgArray<Vertex>& VList = a_mesh.GetVertices();
+
+	if (isLit.size() != VList.size())
+		return;
+
+	for (uint32 i = 0; i < VList.size(); ++i)
+	{
+		if (VList[i].state == 'x')
+			continue;
+
+		colors[i] = VList[i].clr;
+		isLit[i] = true;
+	}
+
+	//Reactivate
+	for (uint32 i = 0; i < fetched.size(); ++i)
+		VList[fetched[i]].state = 'a';
+
+	fetched.clear();
+
+}	//End: LightCache::Store()
@@ -0,0 +1,84 @@
+/*!
+* @file LightCache.h
+*
+* Class header: LightCache
+*/
+
+#ifndef LIGHTCACHE_H
+#define LIGHTCACHE_H
+
+#include "DgArray.h"
+#include "DgTypes.h"
+#include "Tuple.h"
+#include "VQS.h"
+
+class Mesh;
+
+/*!
+ * @ingroup lights
+ *
+ * @class LightCache
+ *
+ * @brief Stores the lit vertex colors of a mesh instance between frames.
+ *
+ * Meshes are shared between aspects, so the result of lighting a mesh
+ * is copied out of the mesh and kept with the aspect. The colors are
+ * keyed on the mesh, the world transform of the aspect and a list of
+ * values describing the lights that touched it (light IDs and their
+ * stamps). When the key changes, every vertex is flagged as unlit.
+ *
+ * Vertices are lit on demand. Fetch() fills in the active vertices that
+ * already have a color and deactivates them, so the lights only touch
+ * the vertices still missing one. Store() saves those and reactivates
+ * the fetched vertices.
+ *
+ * Ambient and directional lights, and materials, are level data and are
+ * not part of the key. Call Invalidate() if these are changed.
+ */
+class LightCache
+{
+public:
+	//Constructor / destructor
+	LightCache(): isValid(false), mesh(NULL) {}
+	~LightCache() {}
+
+	//Copy operations
+	LightCache(const LightCache&);
+	LightCache& operator= (const LightCache&);
+
+	//! Flag the cache as out of date.
+	void Invalidate() {isValid = false;}
+
+	//! Flags all vertices as unlit if the key differs from the stored key.
+	void Validate(const Mesh&, const VQS& T_WLD_OBJ, const DgArray<uint32>& key);
+
+	/*!
+	* @brief Copy cached colors to the active vertices of the mesh and
+	* deactivate them.
+	*
+	* @return The number of active vertices without a cached color.
+	*/
+	uint32 Fetch(Mesh&);
+
+	//! Cache the colors of the active vertices, then reactivate fetched vertices.
+	void Store(Mesh&);
+
+private:
+	//Data members
+	bool isValid;
+
+	//Key
+	const Mesh* mesh;
+	VQS T_WLD_OBJ;
+	DgArray<uint32> key;
+
+	//Lit vertex colors, in the same order as the mesh vertex list.
+	DgArray<Tuple<float>> colors;
+	DgArray<bool> isLit;
+
+	//Vertices deactivated in Fetch().
+	DgArray<uint32> fetched;
+
+};
+
+#endif
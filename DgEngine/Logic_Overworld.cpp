@@ -3,6 +3,7 @@
 #include "DgTypes.h"
 #include "Component_MOVEMENT.h"
 #include "Systems.h"
+#include "CameraPath.h"
 
 //--------------------------------------------------------------------------------
 //		Logic
@@ -12,9 +13,21 @@ void Overworld::Logic()
    // while (timer.Time() % 200) {  }
 
     //Get dt
-    dt = timer.Lap();
-
-	float dtf = float(dt) / 1000.0f;
+	float dtf;
+	uint32 now;
+	if (fixedStep > 0.0f)
+	{
+		dtf = fixedStep;
+		dt = uint32(fixedStep * 1000.0f + 0.5f);
+		now = uint32(float(steps) * fixedStep * 1000.0f + 0.5f);
+		++steps;
+	}
+	else
+	{
+		dt = timer.Lap();
+		dtf = float(dt) / 1000.0f;
+		now = timer.Time();
+	}
 
 	//Assign/Deassign cameras
 	//TODO Remove this. Deal with this as requests are made.
@@ -25,8 +38,40 @@ void Overworld::Logic()
 	//Update the player movement
 	SYSTEM_CameraControl(gameData, cameraControls, dtf);
 
+	//Or place the player on the camera path
+	if (cameraPath)
+	{
+		int index;
+		if (gameData.Positions.find(gameData.player, index))
+			gameData.Positions[index].T_PAR_OBJ = cameraPath->At(float(now) / 1000.0f);
+
+		if (gameData.Movements.find(gameData.player, index))
+		{
+			Component_MOVEMENT& movement = gameData.Movements[index];
+			movement.direction = Vector4::origin;
+			movement.yaw = movement.pitch = movement.roll = 0.0f;
+		}
+	}
+
 	//Update data
 	SYSTEM_Move(gameData, dtf);
+
+	//Record where the player went
+	if (pathRecord.is_open())
+	{
+		int index;
+		if (gameData.Positions.find(gameData.player, index))
+		{
+			const VQS& vqs = gameData.Positions[index].T_PAR_OBJ;
+			const Vector4& v = vqs.V();
+			const Quaternion& q = vqs.Q();
+			pathRecord << recordTime << '\t'
+				<< v.X() << ' ' << v.Y() << ' ' << v.Z() << '\t'
+				<< q.W() << ' ' << q.X() << ' ' << q.Y() << ' ' << q.Z() << '\t'
+				<< vqs.S() << '\n';
+		}
+		recordTime += dtf;
+	}
 	SYSTEM_UpdatePositionHierarchies(gameData);
 	SYSTEM_UpdatePhysics(gameData);
 	SYSTEM_UpdateLights(gameData);
@@ -40,10 +85,32 @@ void Overworld::Logic()
 	SYSTEM_CameraPost(gameData);
 
 	//Add objects to the render lists
-	SYSTEM_Add_Entities(gameData, timer.Time());
+	SYSTEM_Add_Entities(gameData, now);
 	SYSTEM_Add_Skyboxes(gameData);
 
 	//Render the render lists
 	SYSTEM_Render(gameData);
 
-}	//End: Overworld::Logic()
\ No newline at end of file
+}	//End: Overworld::Logic()
+
+
+//--------------------------------------------------------------------------------
+//		Set a fixed time step
+//--------------------------------------------------------------------------------
+void Overworld::SetFixedStep(float step)
+{
+	fixedStep = (step > 0.0f) ? step : 0.0f;
+	steps = 0;
+	timer.Lap();
+
+}	//End: Overworld::SetFixedStep()
+
+
+//--------------------------------------------------------------------------------
+//		Set the camera path
+//--------------------------------------------------------------------------------
+void Overworld::SetCameraPath(const CameraPath* path)
+{
+	cameraPath = path;
+
+}	//End: Overworld::SetCameraPath()
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*!
+* @file MappedFile.cpp
+*
+* Class definitions: MappedFile
+*/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+//--------------------------------------------------------------------------------
+//	@	MappedFile::MappedFile()
+//--------------------------------------------------------------------------------
+//		Constructor
+//--------------------------------------------------------------------------------
+MappedFile::MappedFile(): data(NULL), size(0),
+#ifdef _WIN32
+	file(INVALID_HANDLE_VALUE), mapping(NULL)
+#else
+	file(-1)
+#endif
+{
+}	//End: MappedFile::MappedFile()
+
+
+#ifdef _WIN32
+
+//--------------------------------------------------------------------------------
+//	@	MappedFile::Open()
+//--------------------------------------------------------------------------------
+//		Map a file
+//--------------------------------------------------------------------------------
+bool MappedFile::Open(const std::string& name)
+{
+	Close();
+
+	file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	data = static_cast<const uint8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	size = size_t(fileSize.QuadPart);
+	return true;
+
+}	//End: MappedFile::Open()
+
+
+//--------------------------------------------------------------------------------
+//	@	MappedFile::Close()
+//--------------------------------------------------------------------------------
+//		Unmap the file
+//--------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+	if (data != NULL)
+		UnmapViewOfFile(data);
+
+	if (mapping != NULL)
+		CloseHandle(mapping);
+
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+
+	data = NULL;
+	size = 0;
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+
+}	//End: MappedFile::Close()
+
+#else
+
+//--------------------------------------------------------------------------------
+//	@	MappedFile::Open()
+//--------------------------------------------------------------------------------
+//		Map a file
+//--------------------------------------------------------------------------------
+bool MappedFile::Open(const std::string& name)
+{
+	Close();
+
+	file = open(name.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+
+	void* ptr = mmap(NULL, size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	if (ptr == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	data = static_cast<const uint8*>(ptr);
+	size = size_t(info.st_size);
+	return true;
+
+}	//End: MappedFile::Open()
+
+
+//--------------------------------------------------------------------------------
+//	@	MappedFile::Close()
+//--------------------------------------------------------------------------------
+//		Unmap the file
+//--------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+	if (data != NULL)
+		munmap(const_cast<uint8*>(data), size);
+
+	if (file >= 0)
+		close(file);
+
+	data = NULL;
+	size = 0;
+	file = -1;
+
+}	//End: MappedFile::Close()
+
+#endif
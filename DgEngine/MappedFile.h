@@ -0,0 +1,59 @@
+/*!
+* @file MappedFile.h
+*
+* Class header: MappedFile
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <stddef.h>
+#include "DgTypes.h"
+
+/*!
+ * @ingroup utility
+ *
+ * @class MappedFile
+ *
+ * @brief Maps a file read-only into memory.
+ *
+ * The file stays mapped until Close() is called or the object is
+ * destroyed.
+ */
+class MappedFile
+{
+public:
+	//Constructor / destructor
+	MappedFile();
+	~MappedFile() {Close();}
+
+	//! Map a file. Returns false if the file could not be opened or is empty.
+	bool Open(const std::string&);
+
+	//! Unmap the file.
+	void Close();
+
+	const uint8* Data() const {return data;}
+	size_t Size() const {return size;}
+
+private:
+	//Data members
+	const uint8* data;
+	size_t size;
+
+#ifdef _WIN32
+	void* file;
+	void* mapping;
+#else
+	int file;
+#endif
+
+private:
+	//DISALLOW Copy operations
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+};
+
+#endif
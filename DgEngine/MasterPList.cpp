@@ -13,7 +13,16 @@
 #include "MasterPList.h"
 #include "Polygon.h"
 #include "Rasterizer.h"
+#include "Profiler.h"
+#include "RasterCapture.h"
 #include <algorithm>
+#include <iostream>
+
+
+//--------------------------------------------------------------------------------
+//		Statics
+//--------------------------------------------------------------------------------
+std::string MasterPList::captureFile;
 
 
 //--------------------------------------------------------------------------------
@@ -191,8 +200,16 @@ void MasterPList::SortAlphas()
 void MasterPList::SendToRasterizer(Rasterizer& output)
 {
 	//Sort the drawables
-	SortPolygons();
-	SortAlphas();
+	{
+		ProfileScope profile(Profiler::SORT);
+		SortPolygons();
+		SortAlphas();
+	}
+
+	if (!captureFile.empty())
+		Capture(output);
+
+	ProfileScope profile(Profiler::RASTERIZE);
 
 	//Obtain underlying array
 	SortContainer<Polygon_RASTER, float> *Sorted_P = PList_Sorted.Data();
@@ -222,6 +239,49 @@ void MasterPList::SendToRasterizer(Rasterizer& output)
 }	//End: MasterPList::Draw()
 
 
+//--------------------------------------------------------------------------------
+//	@	MasterPList::Capture()
+//--------------------------------------------------------------------------------
+//		Save the sorted lists, in the order they are drawn
+//--------------------------------------------------------------------------------
+void MasterPList::Capture(const Rasterizer& output)
+{
+	RasterCapture capture;
+	capture.Clear(output.OutputWidth(), output.OutputHeight());
+
+	SortContainer<Polygon_RASTER, float> *Sorted_P = PList_Sorted.Data();
+	for (int32 i = PList_Sorted.size() - 1; i > -1; --i)
+	{
+		capture.Add(*(Sorted_P[i].ptr));
+	}
+
+	for (uint32 i = 0; i < SkyboxList.size(); ++i)
+	{
+		capture.Add(SkyboxList[i]);
+	}
+
+	//Alpha items are either polygons or particles
+	SortContainer<Drawable, float>* Sorted_A = AList_Sorted.Data();
+	for (int32 i = AList_Sorted.size() - 1; i > -1; --i)
+	{
+		const Polygon_RASTER* polygon = dynamic_cast<const Polygon_RASTER*>(Sorted_A[i].ptr);
+		if (polygon)
+			capture.Add(*polygon);
+		else
+			capture.Add(*static_cast<const Particle_RASTER*>(Sorted_A[i].ptr));
+	}
+
+	if (capture.Write(captureFile))
+	{
+		std::cerr << "@MasterPList::Capture() -> Saved " << capture.Triangles() << " triangles and "
+			<< capture.Particles() << " particles to " << captureFile << std::endl;
+	}
+
+	captureFile.clear();
+
+}	//End: MasterPList::Capture()
+
+
 //--------------------------------------------------------------------------------
 //	@	MasterPList::Reset()
 //--------------------------------------------------------------------------------
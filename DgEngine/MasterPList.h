@@ -22,6 +22,7 @@
 #include "SortContainer.h"
 #include "DgArray.h"
 #include "DgTypes.h"
+#include <string>
 
 struct Polygon;
 class Point4;
@@ -54,6 +55,10 @@ public:
 	//Draw polygons to screen
 	void SendToRasterizer(Rasterizer&);
 
+	//Save the draw stream of the next SendToRasterizer() call, from any
+	//list, to a file. See RasterCapture.
+	static void CaptureNext(const std::string& file) {captureFile = file;}
+
 	//Effectively clears list, ready for new polygons to be added
 	void Reset();
 
@@ -70,6 +75,9 @@ private:
 	DgArray<SortContainer<Polygon_RASTER, float>>  PList_Sorted;
 	DgArray<SortContainer<Drawable, float>>		   AList_Sorted;
 
+	//Where to save the next draw stream, if set
+	static std::string captureFile;
+
 	//--------------------------------------------------------------------------------
 	//		Functions
 	//--------------------------------------------------------------------------------
@@ -81,6 +89,9 @@ private:
 	void SortPolygons();
 	void SortAlphas();
 
+	//Write the sorted lists to captureFile
+	void Capture(const Rasterizer&);
+
 };
 
 
@@ -14,7 +14,124 @@
 #include "Sphere.h"
 #include "MasterPList.h"
 #include "Viewport.h"
+#include "Frustum.h"
+#include "CommonMath.h"
 #include <list>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		Sort key used to group polygons into clusters
+//--------------------------------------------------------------------------------
+struct ClusterKey
+{
+	uint32 key;		//Facing, then position along a Morton curve
+	uint32 index;
+
+	bool operator<(const ClusterKey& other) const {return key < other.key;}
+};
+
+static const uint32 MORTON_BITS = 9;
+
+//Polygons wanted per pixel of screen area covered by a mesh
+static const float LOD_DENSITY = 1.0f / 16.0f;
+
+//Fraction the polygon target must pass a level's count by to switch
+static const float LOD_HYSTERESIS = 0.25f;
+
+
+//--------------------------------------------------------------------------------
+//	@	SpreadBits()
+//--------------------------------------------------------------------------------
+//		Move the low 9 bits of a value to every third bit
+//--------------------------------------------------------------------------------
+static uint32 SpreadBits(uint32 x)
+{
+	x &= 0x3FF;
+	x = (x | (x << 16)) & 0x030000FF;
+	x = (x | (x << 8)) & 0x0300F00F;
+	x = (x | (x << 4)) & 0x030C30C3;
+	x = (x | (x << 2)) & 0x09249249;
+	return x;
+
+}	//End: SpreadBits()
+
+
+//--------------------------------------------------------------------------------
+//	@	FacingBucket()
+//--------------------------------------------------------------------------------
+//		Which of the 6 axis directions a normal is closest to
+//--------------------------------------------------------------------------------
+static uint32 FacingBucket(const Vector4& n)
+{
+	uint32 axis = 0;
+	for (uint32 i = 1; i < 3; ++i)
+	{
+		if (DgAbs(n[i]) > DgAbs(n[axis]))
+			axis = i;
+	}
+
+	return axis * 2 + ((n[axis] < 0.0f) ? 1 : 0);
+
+}	//End: FacingBucket()
+
+
+//--------------------------------------------------------------------------------
+//		Vertices are welded on their exact position and normal
+//--------------------------------------------------------------------------------
+struct WeldKey
+{
+	float val[6];
+
+	bool operator==(const WeldKey& other) const 
+	{return memcmp(val, other.val, sizeof(val)) == 0;}
+};
+
+struct WeldKeyHash
+{
+	//FNV-1a over the key bytes
+	size_t operator()(const WeldKey& key) const
+	{
+		const uint8* bytes = reinterpret_cast<const uint8*>(key.val);
+		uint32 hash = 2166136261u;
+		for (size_t i = 0; i < sizeof(key.val); ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 16777619u;
+		}
+		return size_t(hash);
+	}
+};
+
+typedef std::unordered_map<WeldKey, uint32, WeldKeyHash> WeldMap;
+
+
+//--------------------------------------------------------------------------------
+//	@	WeldVertex()
+//--------------------------------------------------------------------------------
+//		Index of a vertex in the list, the vertex is added if not found.
+//--------------------------------------------------------------------------------
+static uint32 WeldVertex(WeldMap& weld, std::vector<Vertex>& vertices, const Vertex& v)
+{
+	WeldKey key;
+	for (int i = 0; i < 3; ++i)
+	{
+		key.val[i] = v.position[i];
+		key.val[i + 3] = v.normal[i];
+	}
+
+	std::pair<WeldMap::iterator, bool> result = 
+		weld.insert(WeldMap::value_type(key, uint32(vertices.size())));
+
+	if (result.second)
+		vertices.push_back(v);
+
+	return result.first->second;
+
+}	//End: WeldVertex()
 
 
 //--------------------------------------------------------------------------------
@@ -57,9 +174,12 @@ Mesh& Mesh::operator=(const Mesh& other)
 //--------------------------------------------------------------------------------
 DgReader& operator>> (DgReader& in, Mesh& dest)
 {
-	//Create temp lists to read to
-	std::list<Polygon> temp_PList;
-	std::list<Vertex> temp_VList;
+	//Create temp lists to read to. Polygons refer to vertices by index
+	//until the final lists are built.
+	std::vector<Polygon> temp_PList;
+	std::vector<Vertex> temp_VList;
+	std::vector<uint32> corners;
+	WeldMap weld;
 
 	//Temp containers for input
 	char chk;
@@ -122,7 +242,7 @@ DgReader& operator>> (DgReader& in, Mesh& dest)
 			vertex_temp.normal = v_norm[normal_ref-1];
 				
 			//Add to Polygon
-			poly_temp.p0 = FindAdd(temp_VList, vertex_temp);
+			corners.push_back(WeldVertex(weld, temp_VList, vertex_temp));
 			poly_temp.uv0 = v_uv[texel_ref-1];
 
 
@@ -133,7 +253,7 @@ DgReader& operator>> (DgReader& in, Mesh& dest)
 			vertex_temp.normal = v_norm[normal_ref-1];
 				
 			//Add to Polygon
-			poly_temp.p1 = FindAdd(temp_VList, vertex_temp);
+			corners.push_back(WeldVertex(weld, temp_VList, vertex_temp));
 			poly_temp.uv1 = v_uv[texel_ref-1];
 
 
@@ -144,13 +264,14 @@ DgReader& operator>> (DgReader& in, Mesh& dest)
 			vertex_temp.normal = v_norm[normal_ref-1];
 				
 			//Add to Polygon
-			poly_temp.p2 = FindAdd(temp_VList, vertex_temp);
+			corners.push_back(WeldVertex(weld, temp_VList, vertex_temp));
 			poly_temp.uv2 = v_uv[texel_ref-1];
 
 			//Assign plane
-			poly_temp.plane.Set(poly_temp.p0->position, 
-								poly_temp.p1->position, 
-								poly_temp.p2->position);
+			size_t c = corners.size() - 3;
+			poly_temp.plane.Set(temp_VList[corners[c]].position, 
+								temp_VList[corners[c + 1]].position, 
+								temp_VList[corners[c + 2]].position);
 
 			//Add Polygon to PList
 			temp_PList.push_back(poly_temp);
@@ -171,42 +292,37 @@ DgReader& operator>> (DgReader& in, Mesh& dest)
 	dest.VList.resize(uint32(temp_VList.size()));
 
 	//Copy contents of VList
-	std::list<Vertex>::iterator vit = temp_VList.begin();
-	for (; vit != temp_VList.end(); ++vit)
-		dest.VList.push_back(*vit);
+	for (size_t i = 0; i < temp_VList.size(); ++i)
+		dest.VList.push_back(temp_VList[i]);
 
 	//Copy contents of PList
-	std::list<Polygon>::iterator pit = temp_PList.begin();
-	for (; pit != temp_PList.end(); ++pit)
+	for (size_t i = 0; i < temp_PList.size(); ++i)
 	{
 		//Assign data
-		Polygon poly = *pit;
+		Polygon poly = temp_PList[i];
 
 		//Assign pointers
-		poly.p0 = find(dest.VList, *pit->p0);
-		poly.p1 = find(dest.VList, *pit->p1);
-		poly.p2 = find(dest.VList, *pit->p2);
-
-		//Check for errors
-        if (poly.p0 == NULL || poly.p1 == NULL || poly.p2 == NULL)
-        {
-            std::cerr << "@Mesh::operator>>() -> Not all pointers assigned" << std::endl;
-        }
+		poly.p0 = &dest.VList[corners[3*i]];
+		poly.p1 = &dest.VList[corners[3*i + 1]];
+		poly.p2 = &dest.VList[corners[3*i + 2]];
 
 		//Add polygon
 		dest.PList.push_back(poly);
 	}
 
+	dest.BuildClusters();
+	dest.OptimizeVertexCache();
+
 	return in;
 }	//End: operator>>(Mesh)
 
 
 //--------------------------------------------------------------------------------
-//		Back culling given a camera position
+//		Back culling of a range of polygons given a camera position
 //--------------------------------------------------------------------------------
-void Mesh::BackCull(const Point4& p)
+void Mesh::BackCullPolygons(uint32 first, uint32 count, const Point4& p)
 {
-	for (uint32 i = 0; i < PList.size(); ++i)
+	for (uint32 i = first; i < first + count; ++i)
 	{
 		if (PList[i].plane.Test(p) < 0.0f)
 			PList[i].state = 'x';	//Deactivate polygon
@@ -218,9 +334,517 @@ void Mesh::BackCull(const Point4& p)
 		}
 	}
 
+}	//End: Mesh::BackCullPolygons()
+
+
+//--------------------------------------------------------------------------------
+//		Back culling given a camera position
+//--------------------------------------------------------------------------------
+void Mesh::BackCull(const Point4& p)
+{
+	//Mesh has not been clustered
+	if (clusters.size() == 0)
+	{
+		BackCullPolygons(0, PList.size(), p);
+		return;
+	}
+
+	for (uint32 c = 0; c < clusters.size(); ++c)
+	{
+		const MeshCluster& cluster = clusters[c];
+
+		if (cluster.IsBackFacing(p))
+		{
+			for (uint32 i = cluster.first; i < cluster.first + cluster.count; ++i)
+				PList[i].state = 'x';
+			continue;
+		}
+
+		BackCullPolygons(cluster.first, cluster.count, p);
+	}
+
+}	//End: Mesh::BackCull()
+
+
+//--------------------------------------------------------------------------------
+//		Back and frustum culling. Clusters are rejected whole if they face
+//		away from the camera or lie outside the frustum.
+//--------------------------------------------------------------------------------
+void Mesh::BackCull(const Point4& p, const Frustum& frustum, const VQS& T_WLD_OBJ, uint8 planes)
+{
+	//Nothing to test against the frustum
+	if (planes == Frustum::INSIDE || clusters.size() == 0)
+	{
+		BackCull(p);
+		return;
+	}
+
+	for (uint32 c = 0; c < clusters.size(); ++c)
+	{
+		MeshCluster& cluster = clusters[c];
+
+		bool reject = cluster.IsBackFacing(p);
+		if (!reject)
+		{
+			Sphere bounds(cluster.bounds);
+			bounds.TransformQuick(T_WLD_OBJ);
+			reject = (TestFrustumSphere(frustum, bounds, planes, cluster.lastPlane) 
+				== Frustum::OUTSIDE);
+		}
+
+		if (reject)
+		{
+			for (uint32 i = cluster.first; i < cluster.first + cluster.count; ++i)
+				PList[i].state = 'x';
+			continue;
+		}
+
+		BackCullPolygons(cluster.first, cluster.count, p);
+	}
+
 }	//End: Mesh::BackCull()
 
 
+//--------------------------------------------------------------------------------
+//		Split the polygons into clusters. Polygons are sorted by which way
+//		they face, then by position, and the sorted list is cut into runs.
+//		Small meshes are a single cluster and keep their polygon order.
+//--------------------------------------------------------------------------------
+void Mesh::BuildClusters()
+{
+	clusters.clear();
+
+	if (PList.size() == 0)
+		return;
+
+	if (PList.size() <= MeshCluster::MAXSIZE)
+	{
+		MeshCluster cluster;
+		cluster.first = 0;
+		cluster.count = PList.size();
+		SetClusterBounds(cluster);
+		clusters.push_back(cluster);
+		return;
+	}
+
+	//Bounds of the polygon centers
+	Point4 lower(Center(PList[0]));
+	Point4 upper(lower);
+	for (uint32 i = 1; i < PList.size(); ++i)
+	{
+		Point4 c(Center(PList[i]));
+		for (int j = 0; j < 3; ++j)
+		{
+			lower[j] = DgMin(lower[j], c[j]);
+			upper[j] = DgMax(upper[j], c[j]);
+		}
+	}
+
+	//Build keys
+	const float maxCell = float((1 << MORTON_BITS) - 1);
+	std::vector<ClusterKey> keys(PList.size());
+	for (uint32 i = 0; i < PList.size(); ++i)
+	{
+		Point4 c(Center(PList[i]));
+		uint32 code = 0;
+		for (int j = 0; j < 3; ++j)
+		{
+			float extent = upper[j] - lower[j];
+			uint32 cell = 0;
+			if (extent > EPSILON)
+				cell = uint32((c[j] - lower[j]) / extent * maxCell);
+			code |= SpreadBits(cell) << j;
+		}
+
+		keys[i].key = (FacingBucket(PList[i].plane.Normal()) << (3 * MORTON_BITS)) | code;
+		keys[i].index = i;
+	}
+
+	std::sort(keys.begin(), keys.end());
+
+	//Reorder polygons
+	DgArray<Polygon> sorted;
+	sorted.resize(PList.size());
+	for (uint32 i = 0; i < keys.size(); ++i)
+		sorted.push_back(PList[keys[i].index]);
+	PList = sorted;
+
+	//Cut into clusters where the facing changes or the cluster is full
+	MeshCluster cluster;
+	uint32 lastFacing = keys[0].key >> (3 * MORTON_BITS);
+	for (uint32 i = 0; i < keys.size(); ++i)
+	{
+		uint32 facing = keys[i].key >> (3 * MORTON_BITS);
+		if (cluster.count == MeshCluster::MAXSIZE || facing != lastFacing)
+		{
+			clusters.push_back(cluster);
+			cluster.first = i;
+			cluster.count = 0;
+		}
+
+		++cluster.count;
+		lastFacing = facing;
+	}
+	clusters.push_back(cluster);
+
+	for (uint32 c = 0; c < clusters.size(); ++c)
+		SetClusterBounds(clusters[c]);
+
+}	//End: Mesh::BuildClusters()
+
+
+//--------------------------------------------------------------------------------
+//		Bounding sphere and normal cone of a cluster
+//--------------------------------------------------------------------------------
+void Mesh::SetClusterBounds(MeshCluster& cluster) const
+{
+	const uint32 end = cluster.first + cluster.count;
+
+	//Sphere about the center of the vertex bounds
+	Point4 lower(PList[cluster.first].p0->position);
+	Point4 upper(lower);
+	for (uint32 i = cluster.first; i < end; ++i)
+	{
+		const Vertex* v[3] = {PList[i].p0, PList[i].p1, PList[i].p2};
+		for (int k = 0; k < 3; ++k)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				lower[j] = DgMin(lower[j], v[k]->position[j]);
+				upper[j] = DgMax(upper[j], v[k]->position[j]);
+			}
+		}
+	}
+
+	Point4 center((lower[0] + upper[0]) * 0.5f,
+				  (lower[1] + upper[1]) * 0.5f,
+				  (lower[2] + upper[2]) * 0.5f);
+
+	float sqRadius = 0.0f;
+	for (uint32 i = cluster.first; i < end; ++i)
+	{
+		sqRadius = DgMax(sqRadius, (PList[i].p0->position - center).LengthSquared());
+		sqRadius = DgMax(sqRadius, (PList[i].p1->position - center).LengthSquared());
+		sqRadius = DgMax(sqRadius, (PList[i].p2->position - center).LengthSquared());
+	}
+
+	cluster.bounds.Set(center, DgSqrt(sqRadius));
+
+	//Normal cone. Disabled if the normals spread over a hemisphere.
+	cluster.cutoff = 1.0f;
+	cluster.axis.Zero();
+	for (uint32 i = cluster.first; i < end; ++i)
+		cluster.axis += PList[i].plane.Normal();
+
+	if (cluster.axis.LengthSquared() < EPSILON)
+		return;
+
+	cluster.axis.Normalize();
+
+	float minDot = 1.0f;
+	for (uint32 i = cluster.first; i < end; ++i)
+		minDot = DgMin(minDot, Dot(cluster.axis, PList[i].plane.Normal()));
+
+	if (minDot > 0.0f)
+		cluster.cutoff = DgSqrt(1.0f - minDot * minDot);
+
+}	//End: Mesh::SetClusterBounds()
+
+
+//--------------------------------------------------------------------------------
+//		Vertex cache scoring, after Tom Forsyth's linear-speed optimizer
+//--------------------------------------------------------------------------------
+static const int VCACHE_SIZE = 32;
+static const float VCACHE_DECAY = 1.5f;
+static const float VCACHE_LAST_TRI = 0.75f;
+static const float VCACHE_VALENCE_SCALE = 2.0f;
+static const float VCACHE_VALENCE_POWER = 0.5f;
+
+
+//--------------------------------------------------------------------------------
+//	@	VertexScore()
+//--------------------------------------------------------------------------------
+//		Score of a vertex given its cache position (-1 if not cached) and 
+//		number of triangles still to be added which use it.
+//--------------------------------------------------------------------------------
+static float VertexScore(int cachePos, uint32 remaining)
+{
+	if (remaining == 0)
+		return -1.0f;
+
+	float score = 0.0f;
+	if (cachePos >= 0)
+	{
+		if (cachePos < 3)
+			score = VCACHE_LAST_TRI;
+		else
+		{
+			float scale = 1.0f / float(VCACHE_SIZE - 3);
+			score = DgPow(1.0f - float(cachePos - 3) * scale, VCACHE_DECAY);
+		}
+	}
+
+	score += VCACHE_VALENCE_SCALE * DgPow(float(remaining), -VCACHE_VALENCE_POWER);
+	return score;
+
+}	//End: VertexScore()
+
+
+//--------------------------------------------------------------------------------
+//	@	VertexCacheOrder()
+//--------------------------------------------------------------------------------
+//		Triangle order for a list of triangles given as vertex indices 
+//		in [0, nVertices).
+//--------------------------------------------------------------------------------
+static void VertexCacheOrder(const std::vector<uint32>& indices, uint32 nVertices,
+							 std::vector<uint32>& order)
+{
+	const uint32 nTris = uint32(indices.size() / 3);
+	order.clear();
+	order.reserve(nTris);
+
+	//Triangles using each vertex
+	std::vector<uint32> remaining(nVertices, 0);
+	for (size_t i = 0; i < indices.size(); ++i)
+		++remaining[indices[i]];
+
+	std::vector<uint32> offset(nVertices + 1, 0);
+	for (uint32 v = 0; v < nVertices; ++v)
+		offset[v + 1] = offset[v] + remaining[v];
+
+	std::vector<uint32> adjacency(indices.size());
+	std::vector<uint32> fill(offset.begin(), offset.end() - 1);
+	for (uint32 t = 0; t < nTris; ++t)
+		for (int k = 0; k < 3; ++k)
+			adjacency[fill[indices[3*t + k]]++] = t;
+
+	//Initial scores
+	std::vector<int> cachePos(nVertices, -1);
+	std::vector<float> vScore(nVertices);
+	for (uint32 v = 0; v < nVertices; ++v)
+		vScore[v] = VertexScore(-1, remaining[v]);
+
+	std::vector<float> tScore(nTris);
+	std::vector<bool> added(nTris, false);
+	int best = -1;
+	float bestScore = -1.0f;
+	for (uint32 t = 0; t < nTris; ++t)
+	{
+		tScore[t] = vScore[indices[3*t]] + vScore[indices[3*t + 1]] + vScore[indices[3*t + 2]];
+		if (tScore[t] > bestScore)
+		{
+			bestScore = tScore[t];
+			best = int(t);
+		}
+	}
+
+	std::vector<uint32> cache, newCache;
+	cache.reserve(VCACHE_SIZE + 3);
+	newCache.reserve(VCACHE_SIZE + 3);
+	uint32 cursor = 0;
+
+	while (order.size() < nTris)
+	{
+		//Nothing in the cache to build on, take the next unused triangle
+		if (best < 0)
+		{
+			while (added[cursor])
+				++cursor;
+			best = int(cursor);
+		}
+
+		const uint32 tri = uint32(best);
+		added[tri] = true;
+		order.push_back(tri);
+
+		//Remove the triangle from its vertices and put them at the front of the cache
+		newCache.clear();
+		for (int k = 0; k < 3; ++k)
+		{
+			uint32 v = indices[3*tri + k];
+			uint32* first = &adjacency[offset[v]];
+			uint32* last = first + remaining[v];
+			std::iter_swap(std::find(first, last, tri), last - 1);
+			--remaining[v];
+			newCache.push_back(v);
+		}
+
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			uint32 v = cache[i];
+			if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+				newCache.push_back(v);
+		}
+
+		//Vertices pushed out of the cache
+		for (size_t i = VCACHE_SIZE; i < newCache.size(); ++i)
+		{
+			uint32 v = newCache[i];
+			cachePos[v] = -1;
+			vScore[v] = VertexScore(-1, remaining[v]);
+		}
+		if (newCache.size() > size_t(VCACHE_SIZE))
+			newCache.resize(VCACHE_SIZE);
+
+		for (size_t i = 0; i < newCache.size(); ++i)
+		{
+			uint32 v = newCache[i];
+			cachePos[v] = int(i);
+			vScore[v] = VertexScore(int(i), remaining[v]);
+		}
+		cache.swap(newCache);
+
+		//Rescore triangles touching the cache, pick the best
+		best = -1;
+		bestScore = -1.0f;
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			uint32 v = cache[i];
+			for (uint32 j = offset[v]; j < offset[v] + remaining[v]; ++j)
+			{
+				uint32 t = adjacency[j];
+				tScore[t] = vScore[indices[3*t]] + vScore[indices[3*t + 1]] + vScore[indices[3*t + 2]];
+				if (tScore[t] > bestScore)
+				{
+					bestScore = tScore[t];
+					best = int(t);
+				}
+			}
+		}
+	}
+
+}	//End: VertexCacheOrder()
+
+
+//--------------------------------------------------------------------------------
+//	@	Mesh::OptimizeVertexCache()
+//--------------------------------------------------------------------------------
+//		Reorder polygons within clusters, then vertices in first-use order.
+//		A mesh held in one cluster keeps its polygon order.
+//--------------------------------------------------------------------------------
+void Mesh::OptimizeVertexCache()
+{
+	if (PList.size() == 0)
+		return;
+
+	const Vertex* v0 = &VList[0];
+	const uint32 nVertices = VList.size();
+
+	//Polygon order
+	if (clusters.size() > 1)
+	{
+		std::vector<uint32> localID(nVertices, 0xFFFFFFFF);
+		std::vector<uint32> globalID;
+		std::vector<uint32> indices;
+		std::vector<uint32> order;
+		std::vector<Polygon> polygons;
+
+		for (uint32 c = 0; c < clusters.size(); ++c)
+		{
+			const uint32 first = clusters[c].first;
+			const uint32 count = clusters[c].count;
+
+			//Number the cluster's vertices from 0
+			indices.clear();
+			globalID.clear();
+			for (uint32 i = first; i < first + count; ++i)
+			{
+				const Vertex* v[3] = {PList[i].p0, PList[i].p1, PList[i].p2};
+				for (int k = 0; k < 3; ++k)
+				{
+					uint32 g = uint32(v[k] - v0);
+					if (localID[g] == 0xFFFFFFFF)
+					{
+						localID[g] = uint32(globalID.size());
+						globalID.push_back(g);
+					}
+					indices.push_back(localID[g]);
+				}
+			}
+
+			VertexCacheOrder(indices, uint32(globalID.size()), order);
+
+			polygons.assign(&PList[first], &PList[first] + count);
+			for (uint32 i = 0; i < count; ++i)
+				PList[first + i] = polygons[order[i]];
+
+			for (size_t i = 0; i < globalID.size(); ++i)
+				localID[globalID[i]] = 0xFFFFFFFF;
+		}
+	}
+
+	//Vertex order. New corner indices are found while the polygons
+	//still point into the old list, which is freed when VList is replaced.
+	std::vector<uint32> remap(nVertices, 0xFFFFFFFF);
+	std::vector<uint32> corners(3 * PList.size());
+	DgArray<Vertex> vertices;
+	vertices.resize(nVertices);
+	for (uint32 i = 0; i < PList.size(); ++i)
+	{
+		const Vertex* v[3] = {PList[i].p0, PList[i].p1, PList[i].p2};
+		for (int k = 0; k < 3; ++k)
+		{
+			uint32 g = uint32(v[k] - v0);
+			if (remap[g] == 0xFFFFFFFF)
+			{
+				remap[g] = vertices.size();
+				vertices.push_back(*v[k]);
+			}
+			corners[3*i + k] = remap[g];
+		}
+	}
+
+	VList = vertices;
+	for (uint32 i = 0; i < PList.size(); ++i)
+	{
+		PList[i].p0 = &VList[corners[3*i]];
+		PList[i].p1 = &VList[corners[3*i + 1]];
+		PList[i].p2 = &VList[corners[3*i + 2]];
+	}
+
+}	//End: Mesh::OptimizeVertexCache()
+
+
+//--------------------------------------------------------------------------------
+//		Coarsest level with at least nPolygons polygons
+//--------------------------------------------------------------------------------
+uint8 Mesh::ChooseLOD(float nPolygons) const
+{
+	for (uint32 i = lods.size(); i > 0; --i)
+	{
+		if (float(lods[i - 1]->PList.size()) >= nPolygons)
+			return uint8(i);
+	}
+
+	return 0;
+
+}	//End: Mesh::ChooseLOD()
+
+
+//--------------------------------------------------------------------------------
+//		Choose a level of detail from the projected size of the mesh
+//--------------------------------------------------------------------------------
+uint8 Mesh::SelectLOD(float pixelRadius, uint8 current) const
+{
+	if (lods.size() == 0)
+		return 0;
+
+	float target = LOD_DENSITY * PI * pixelRadius * pixelRadius;
+
+	//Keep the current level while it lies in [lower, upper]
+	uint8 lower = ChooseLOD(target * (1.0f + LOD_HYSTERESIS));
+	uint8 upper = ChooseLOD(target * (1.0f - LOD_HYSTERESIS));
+
+	if (current < lower)
+		return lower;
+	if (current > upper)
+		return upper;
+
+	return current;
+
+}	//End: Mesh::SelectLOD()
+
+
 //--------------------------------------------------------------------------------
 //		Send the object to a renderer
 //--------------------------------------------------------------------------------
@@ -279,6 +903,31 @@ void Mesh::ActivateAll()
 }	//End: Mesh::ActivateAll()
 
 
+//--------------------------------------------------------------------------------
+//		Only keep vertices of active polygons active
+//--------------------------------------------------------------------------------
+void Mesh::UpdateVertexStates()
+{
+	//Deactivate vertices
+	for (uint32 i = 0; i < VList.size(); ++i)
+	{
+		VList[i].state = 'x';
+	}
+
+	//Activate vertices of active polys
+	for (uint32 i = 0; i < PList.size(); ++i)
+	{
+		if (PList[i].state == 'x')
+			continue;
+
+		PList[i].p0->state = 'a';
+		PList[i].p1->state = 'a';
+		PList[i].p2->state = 'a';
+	}
+
+}	//End: Mesh::UpdateVertexStates()
+
+
 //--------------------------------------------------------------------------------
 //		Transform active positions in each vertex.
 //--------------------------------------------------------------------------------
@@ -350,25 +999,41 @@ void Mesh::init(const Mesh& other)
 	//Copy data
 	PList = other.PList;
 	VList = other.VList;
+	clusters = other.clusters;
+
+	ClearLODs();
+	for (uint32 i = 0; i < other.lods.size(); ++i)
+		lods.push_back(new Mesh(*other.lods[i]));
+
+	//Point polygons at the same vertices in our list
+	if (PList.size() == 0)
+		return;
 
-	//Assign Vertexs and UV coords in all polygons
+	const Vertex* other_v0 = &other.VList[0];
+	Vertex* v0 = &VList[0];
 	for (uint32 i = 0; i < PList.size(); ++i)
 	{
-		//Assign Vertexs
-		PList[i].p0 = find(VList, *other.PList[i].p0);
-		PList[i].p1 = find(VList, *other.PList[i].p1);
-		PList[i].p2 = find(VList, *other.PList[i].p2);
-
-		//Check for errors
-        if (PList[i].p0 == NULL || PList[i].p1 == NULL || PList[i].p2 == NULL)
-        {
-            std::cerr << "@Mesh::BuildLists() -> Not all pointers assigned" << std::endl;
-        }
+		PList[i].p0 = v0 + (other.PList[i].p0 - other_v0);
+		PList[i].p1 = v0 + (other.PList[i].p1 - other_v0);
+		PList[i].p2 = v0 + (other.PList[i].p2 - other_v0);
 	}
 
 }	//End: Mesh::BuildLists()
 
 
+//--------------------------------------------------------------------------------
+//		Delete the lower detail levels
+//--------------------------------------------------------------------------------
+void Mesh::ClearLODs()
+{
+	for (uint32 i = 0; i < lods.size(); ++i)
+		delete lods[i];
+
+	lods.clear();
+
+}	//End: Mesh::ClearLODs()
+
+
 
 //--------------------------------------------------------------------------------
 //		Set Sphere and OBB from a mesh
@@ -6,6 +6,7 @@
 #include "DgArray.h"
 #include "Polygon.h"
 #include "Vertex.h"
+#include "MeshCluster.h"
 
 class Point4;
 class Matrix44;
@@ -16,6 +17,7 @@ class Mipmap;
 class Sphere;
 class OBB;
 class Viewport;
+class Frustum;
 
 //--------------------------------------------------------------------------------
 /*
@@ -25,11 +27,12 @@ class Viewport;
 class Mesh
 {
 	friend class Mesh_List;
+	friend class MeshCooker;
 	friend class Materials;
 public:
 	//Constructor/Destructor
 	Mesh();
-	~Mesh() {}
+	~Mesh() {ClearLODs();}
 
 	//Copy operations
 	Mesh(const Mesh&);
@@ -50,12 +53,19 @@ public:
 
 	//Data manipulators for RENDERING purposes ONLY
 	void BackCull(const Point4& p);	//Deactivates polys givin camera position
+
+	//As above, also rejects clusters outside the frustum planes in the mask.
+	//p is in object space, the frustum in world space.
+	void BackCull(const Point4& p, const Frustum&, const VQS& T_WLD_OBJ, uint8 planes);
 	
 	//Reset Polygon and Vertex states:
 	//Polygon on, Vertex off.
 	void ResetStates();
 	void ActivateAll();
 
+	//Deactivate vertices not referenced by an active polygon
+	void UpdateVertexStates();
+
 	//Send polygons to clipper
 	void SendToRenderer( Viewport*, const Materials&, const Mipmap*);
 
@@ -70,15 +80,42 @@ public:
 	//Get the lists
 	DgArray<Polygon>& GetPolygons() {return PList;}
 	DgArray<Vertex>& GetVertices() {return VList;}
+	const DgArray<Polygon>& GetPolygons() const {return PList;}
+	const DgArray<Vertex>& GetVertices() const {return VList;}
+	const DgArray<MeshCluster>& GetClusters() const {return clusters;}
+
+	//Group polygons into clusters. Reorders the polygon list.
+	void BuildClusters();
+
+	//Reorder polygons inside each cluster for vertex cache locality and
+	//lay the vertex list out in first-use order. Unused vertices are dropped.
+	void OptimizeVertexCache();
+
+	//Levels of detail. Level 0 is this mesh, lower detail levels
+	//are built by the mesh list and owned by this mesh. Copies
+	//get their own copies of each level.
+	uint32 NumLODs() const {return lods.size() + 1;}
+	Mesh* GetLOD(uint32 level) {return (level == 0) ? this : lods[level - 1];}
+
+	//Choose a level for a mesh covering a circle of this radius in pixels.
+	//Only moves away from the current level past a margin.
+	uint8 SelectLOD(float pixelRadius, uint8 current) const;
 
 protected:
 	//Data members
 	std::string tag;			//Name of the object
 	DgArray<Polygon>	PList;	//Polygon list
 	DgArray<Vertex>		VList;	//Vertex list
+	DgArray<MeshCluster> clusters;	//Runs of polygons in PList
+	DgArray<Mesh*>		lods;	//Lower detail levels, finest first
 	
 	//Copies lists from other Meshs
 	void init(const Mesh& other);
+	void ClearLODs();
+
+	void BackCullPolygons(uint32 first, uint32 count, const Point4& p);
+	void SetClusterBounds(MeshCluster&) const;
+	uint8 ChooseLOD(float nPolygons) const;
 };
 
 
@@ -0,0 +1,51 @@
+#ifndef MESHCLUSTER_H
+#define MESHCLUSTER_H
+
+#include "Sphere.h"
+#include "Vector4.h"
+#include "Point4.h"
+#include "DgTypes.h"
+
+
+//--------------------------------------------------------------------------------
+/*		A run of polygons in a mesh which are close together and face
+		roughly the same way. The normals of all polygons lie inside a
+		cone about 'axis'. 'cutoff' is the sine of the cone angle, 1 if
+		the cone is too wide to be useful.
+*/
+//--------------------------------------------------------------------------------
+struct MeshCluster
+{
+	//Constructor
+	MeshCluster(): first(0), count(0), cutoff(1.0f), lastPlane(0) {}
+
+	//Maximum polygons in a cluster
+	static const uint32 MAXSIZE = 96;
+
+	//Are all polygons facing away from the point?
+	inline bool IsBackFacing(const Point4& p) const;
+
+	//Data
+	uint32 first;		//Polygon range
+	uint32 count;
+	Sphere bounds;		//Bounds of the polygons, object space
+	Vector4 axis;		//Normal cone
+	float cutoff;
+
+	//Frustum plane which last rejected this cluster
+	uint8 lastPlane;
+};
+
+
+//--------------------------------------------------------------------------------
+//		Conservative test: if the point sees the bounding sphere inside
+//		the reverse of the normal cone, no polygon can face the point.
+//--------------------------------------------------------------------------------
+inline bool MeshCluster::IsBackFacing(const Point4& p) const
+{
+	Vector4 v = bounds.Center() - p;
+	return Dot(v, axis) > cutoff * v.Length() + bounds.Radius();
+
+}	//End: MeshCluster::IsBackFacing()
+
+#endif
@@ -0,0 +1,355 @@
+/*!
+* @file MeshCooker.cpp
+*
+* Class definitions: MeshCooker
+*/
+
+#include "MeshCooker.h"
+#include "MappedFile.h"
+#include "Mesh.h"
+#include <fstream>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		File layout. All records are 4 byte aligned.
+//
+//		Header
+//		Base mesh		MeshHeader, then its blocks as below
+//		Each LOD		The same, finest first
+//
+//		Mesh blocks:
+//		Tag				tagLength chars, padded to 4 bytes
+//		Vertices		CookedVertex[nVertices]
+//		Polygons		CookedPolygon[nPolygons]
+//		Clusters		CookedCluster[nClusters]
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char MAGIC[4] = {'D', 'G', 'M', 'B'};
+	//Bump whenever the layout changes, or the way vertices are welded or
+	//ordered, or detail levels are built, so older cooked files are 
+	//cooked again.
+	const uint32 VERSION = 4;
+
+	//Sanity limit on read
+	const uint32 MAX_LODS = 16;
+
+	struct Header
+	{
+		char magic[4];
+		uint32 version;
+		uint64 sourceSize;
+		uint64 sourceTime;
+		uint32 nLODs;
+		uint32 reserved;
+	};
+
+	struct MeshHeader
+	{
+		uint32 tagLength;
+		uint32 nVertices;
+		uint32 nPolygons;
+		uint32 nClusters;
+	};
+
+	struct CookedVertex
+	{
+		float position[3];
+		float normal[3];
+	};
+
+	struct CookedPolygon
+	{
+		uint32 vertex[3];
+		float uv[6];
+		float plane[4];
+	};
+
+	struct CookedCluster
+	{
+		uint32 first;
+		uint32 count;
+		float center[3];
+		float radius;
+		float axis[3];
+		float cutoff;
+	};
+
+	uint32 PaddedLength(uint32 n) {return (n + 3) & ~uint32(3);}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	MeshCooker::Read()
+//--------------------------------------------------------------------------------
+//		Load a mesh from a cooked file
+//--------------------------------------------------------------------------------
+bool MeshCooker::Read(const std::string& file, const SourceStamp* stamp, Mesh& dest)
+{
+	MappedFile map;
+	if (!map.Open(file))
+		return false;
+
+	return Read(map.Data(), map.Size(), stamp, dest);
+
+}	//End: MeshCooker::Read()
+
+
+//--------------------------------------------------------------------------------
+//	@	MeshCooker::Read()
+//--------------------------------------------------------------------------------
+//		Load a mesh and its detail levels from a cooked block of memory
+//--------------------------------------------------------------------------------
+bool MeshCooker::Read(const uint8* data, size_t size, const SourceStamp* stamp, Mesh& dest)
+{
+	if (size < sizeof(Header))
+		return false;
+
+	const Header* header = reinterpret_cast<const Header*>(data);
+
+	//Check header
+	if (memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION)
+		return false;
+
+	if (!StampMatches(stamp, header->sourceSize, header->sourceTime))
+		return false;
+
+	if (header->nLODs > MAX_LODS)
+	{
+		std::cerr << "@MeshCooker::Read() -> Bad number of detail levels." << std::endl;
+		return false;
+	}
+
+	size_t offset = sizeof(Header);
+	dest.ClearLODs();
+	if (!ReadMesh(data, size, offset, dest))
+		return false;
+
+	for (uint32 i = 0; i < header->nLODs; ++i)
+	{
+		Mesh* lod = new Mesh();
+		dest.lods.push_back(lod);
+
+		if (!ReadMesh(data, size, offset, *lod))
+		{
+			dest.ClearLODs();
+			dest.clusters.clear();
+			dest.PList.clear();
+			dest.VList.clear();
+			return false;
+		}
+	}
+
+	return true;
+
+}	//End: MeshCooker::Read()
+
+
+//--------------------------------------------------------------------------------
+//	@	MeshCooker::ReadMesh()
+//--------------------------------------------------------------------------------
+//		Load one level of a mesh, starting at offset. Moves offset past it.
+//--------------------------------------------------------------------------------
+bool MeshCooker::ReadMesh(const uint8* data, size_t size, size_t& offset, Mesh& dest)
+{
+	if (size < offset + sizeof(MeshHeader))
+	{
+		std::cerr << "@MeshCooker::Read() -> Data is truncated." << std::endl;
+		return false;
+	}
+
+	const MeshHeader* header = reinterpret_cast<const MeshHeader*>(data + offset);
+	offset += sizeof(MeshHeader);
+
+	//Check size
+	size_t expected = offset + PaddedLength(header->tagLength)
+		+ size_t(header->nVertices) * sizeof(CookedVertex)
+		+ size_t(header->nPolygons) * sizeof(CookedPolygon)
+		+ size_t(header->nClusters) * sizeof(CookedCluster);
+
+	if (size < expected)
+	{
+		std::cerr << "@MeshCooker::Read() -> Data is truncated." << std::endl;
+		return false;
+	}
+
+	//Tag
+	dest.tag.assign(reinterpret_cast<const char*>(data + offset), header->tagLength);
+	offset += PaddedLength(header->tagLength);
+
+	//Vertices
+	const CookedVertex* vertices = reinterpret_cast<const CookedVertex*>(data + offset);
+	offset += header->nVertices * sizeof(CookedVertex);
+
+	dest.VList.resize(header->nVertices);
+	for (uint32 i = 0; i < header->nVertices; ++i)
+	{
+		const CookedVertex& cv = vertices[i];
+		Vertex v;
+		v.position.Set(cv.position[0], cv.position[1], cv.position[2]);
+		v.normal.Set(cv.normal[0], cv.normal[1], cv.normal[2]);
+		dest.VList.push_back(v);
+	}
+
+	//Polygons
+	const CookedPolygon* polygons = reinterpret_cast<const CookedPolygon*>(data + offset);
+	offset += header->nPolygons * sizeof(CookedPolygon);
+
+	dest.PList.resize(header->nPolygons);
+	for (uint32 i = 0; i < header->nPolygons; ++i)
+	{
+		const CookedPolygon& cp = polygons[i];
+
+		if (cp.vertex[0] >= header->nVertices ||
+			cp.vertex[1] >= header->nVertices ||
+			cp.vertex[2] >= header->nVertices)
+		{
+			std::cerr << "@MeshCooker::Read() -> Bad vertex index." << std::endl;
+			dest.PList.clear();
+			dest.VList.clear();
+			return false;
+		}
+
+		Polygon p;
+		p.p0 = &dest.VList[cp.vertex[0]];
+		p.p1 = &dest.VList[cp.vertex[1]];
+		p.p2 = &dest.VList[cp.vertex[2]];
+		p.uv0 = Vector2(cp.uv[0], cp.uv[1]);
+		p.uv1 = Vector2(cp.uv[2], cp.uv[3]);
+		p.uv2 = Vector2(cp.uv[4], cp.uv[5]);
+		p.plane.Set(cp.plane[0], cp.plane[1], cp.plane[2], cp.plane[3]);
+		dest.PList.push_back(p);
+	}
+
+	//Clusters
+	const CookedCluster* clusters = reinterpret_cast<const CookedCluster*>(data + offset);
+	offset += header->nClusters * sizeof(CookedCluster);
+
+	dest.clusters.resize(header->nClusters);
+	for (uint32 i = 0; i < header->nClusters; ++i)
+	{
+		const CookedCluster& cc = clusters[i];
+
+		//Clusters are culled by polygon range, which must be in the list
+		if (uint64(cc.first) + uint64(cc.count) > uint64(header->nPolygons))
+		{
+			std::cerr << "@MeshCooker::Read() -> Bad cluster range." << std::endl;
+			dest.clusters.clear();
+			dest.PList.clear();
+			dest.VList.clear();
+			return false;
+		}
+
+		MeshCluster c;
+		c.first = cc.first;
+		c.count = cc.count;
+		c.bounds.Set(Point4(cc.center[0], cc.center[1], cc.center[2]), cc.radius);
+		c.axis.Set(cc.axis[0], cc.axis[1], cc.axis[2]);
+		c.cutoff = cc.cutoff;
+		dest.clusters.push_back(c);
+	}
+
+	return true;
+
+}	//End: MeshCooker::ReadMesh()
+
+
+//--------------------------------------------------------------------------------
+//	@	MeshCooker::Write()
+//--------------------------------------------------------------------------------
+//		Save a mesh and its detail levels to a cooked file
+//--------------------------------------------------------------------------------
+bool MeshCooker::Write(const std::string& file, const SourceStamp& stamp, const Mesh& src)
+{
+	std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+	if (!out)
+		return false;
+
+	//Header
+	Header header;
+	memcpy(header.magic, MAGIC, 4);
+	header.version = VERSION;
+	header.sourceSize = stamp.size;
+	header.sourceTime = stamp.time;
+	header.nLODs = src.lods.size();
+	header.reserved = 0;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	WriteMesh(out, src);
+	for (uint32 i = 0; i < src.lods.size(); ++i)
+		WriteMesh(out, *src.lods[i]);
+
+	return out.good();
+
+}	//End: MeshCooker::Write()
+
+
+//--------------------------------------------------------------------------------
+//	@	MeshCooker::WriteMesh()
+//--------------------------------------------------------------------------------
+//		Save one level of a mesh
+//--------------------------------------------------------------------------------
+void MeshCooker::WriteMesh(std::ofstream& out, const Mesh& src)
+{
+	MeshHeader header;
+	header.tagLength = uint32(src.tag.size());
+	header.nVertices = src.VList.size();
+	header.nPolygons = src.PList.size();
+	header.nClusters = src.clusters.size();
+	out.write(reinterpret_cast<const char*>(&header), sizeof(MeshHeader));
+
+	//Tag
+	const char padding[4] = {0, 0, 0, 0};
+	out.write(src.tag.data(), header.tagLength);
+	out.write(padding, PaddedLength(header.tagLength) - header.tagLength);
+
+	//Vertices
+	for (uint32 i = 0; i < src.VList.size(); ++i)
+	{
+		const Vertex& v = src.VList[i];
+		CookedVertex cv;
+		for (int j = 0; j < 3; ++j)
+		{
+			cv.position[j] = v.position[j];
+			cv.normal[j] = v.normal[j];
+		}
+		out.write(reinterpret_cast<const char*>(&cv), sizeof(CookedVertex));
+	}
+
+	//Polygons
+	const Vertex* v0 = (src.VList.size() > 0) ? &src.VList[0] : NULL;
+	for (uint32 i = 0; i < src.PList.size(); ++i)
+	{
+		const Polygon& p = src.PList[i];
+		CookedPolygon cp;
+		cp.vertex[0] = uint32(p.p0 - v0);
+		cp.vertex[1] = uint32(p.p1 - v0);
+		cp.vertex[2] = uint32(p.p2 - v0);
+		cp.uv[0] = p.uv0.x;	cp.uv[1] = p.uv0.y;
+		cp.uv[2] = p.uv1.x;	cp.uv[3] = p.uv1.y;
+		cp.uv[4] = p.uv2.x;	cp.uv[5] = p.uv2.y;
+		for (int j = 0; j < 3; ++j)
+			cp.plane[j] = p.plane.Normal()[j];
+		cp.plane[3] = p.plane.Offset();
+		out.write(reinterpret_cast<const char*>(&cp), sizeof(CookedPolygon));
+	}
+
+	//Clusters
+	for (uint32 i = 0; i < src.clusters.size(); ++i)
+	{
+		const MeshCluster& c = src.clusters[i];
+		CookedCluster cc;
+		cc.first = c.first;
+		cc.count = c.count;
+		for (int j = 0; j < 3; ++j)
+		{
+			cc.center[j] = c.bounds.Center()[j];
+			cc.axis[j] = c.axis[j];
+		}
+		cc.radius = c.bounds.Radius();
+		cc.cutoff = c.cutoff;
+		out.write(reinterpret_cast<const char*>(&cc), sizeof(CookedCluster));
+	}
+
+}	//End: MeshCooker::WriteMesh()
@@ -0,0 +1,62 @@
+/*!
+* @file MeshCooker.h
+*
+* Class header: MeshCooker
+*/
+
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include <string>
+#include <fstream>
+#include <stddef.h>
+#include "DgTypes.h"
+#include "CookerUtil.h"
+
+class Mesh;
+
+/*!
+ * @ingroup objects
+ *
+ * @class MeshCooker
+ *
+ * @brief Reads and writes meshes in a binary format.
+ *
+ * A cooked mesh holds the welded vertex list, polygons as vertex indices
+ * with their uv coords and planes, and the polygon clusters, followed by
+ * the same for each of its lower detail levels. Everything
+ * is stored in the order and form Mesh uses, so reading is a single pass
+ * over a memory-mapped file with no parsing.
+ *
+ * The header records the size and modification time of the source file.
+ * A cooked file which does not match its source is ignored.
+ */
+class MeshCooker
+{
+public:
+
+	/*!
+	* @brief Load a cooked mesh.
+	*
+	* @param stamp If not NULL, the cooked file must have been made from a
+	* source with this stamp.
+	* @return False if the file is missing, out of date or invalid.
+	*/
+	static bool Read(const std::string& file, const SourceStamp* stamp, Mesh& dest);
+
+	//! Load a cooked mesh from memory, such as an asset archive.
+	static bool Read(const uint8* data, size_t size, const SourceStamp* stamp, Mesh& dest);
+
+	//! Write a cooked mesh, with its detail levels.
+	static bool Write(const std::string& file, const SourceStamp& stamp, const Mesh& src);
+
+private:
+	MeshCooker();
+
+	//One level of a mesh
+	static bool ReadMesh(const uint8* data, size_t size, size_t& offset, Mesh& dest);
+	static void WriteMesh(std::ofstream&, const Mesh& src);
+
+};
+
+#endif
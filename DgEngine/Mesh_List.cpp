@@ -1,37 +1,84 @@
 #include "Mesh_List.h"
+#include "MeshCooker.h"
+#include "AssetArchive.h"
+#include "ResourceLoader.h"
+#include "CommonMath.h"
+#include <map>
+#include <vector>
+#include <sstream>
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------
+//		Level of detail generation
+//--------------------------------------------------------------------------------
+
+//Maximum number of lower detail levels
+static const uint32 MAX_LODS = 4;
+
+//Stop when a level has fewer polygons than this
+static const uint32 MIN_LOD_POLYGONS = 24;
+
+//A level must have at most this fraction of the polygons of the previous
+static const float MIN_LOD_REDUCTION = 0.75f;
 
 
 //--------------------------------------------------------------------------------
 //		Return pointer to a base object
 //--------------------------------------------------------------------------------
-Mesh* Mesh_List::operator[](std::string str)
+Mesh* Mesh_List::operator[](Handle h)
 {
-	std::list<Mesh>::iterator it;
+	Mesh* mesh = meshes.Get(h);
+	if (mesh != NULL)
+		return mesh;
 
-	for(it = OList.begin(); it != OList.end(); it++)
+	//Finish a background load rather than loading twice
+	std::map<Handle, ResourceLoader::Ticket>::iterator it = pending.find(h);
+	if (it != pending.end())
 	{
-		if (it->tag == str)
-			return &(*it);
+		global::LOADER->Wait(it->second);
+		return (*this)[h];
 	}
 
-	return Load(str);
+	return Load(h);
 }	//End: Mesh_List::Get()
 
 
 //--------------------------------------------------------------------------------
-//		Erase element
+//		Start loading a mesh in the background. The mesh is added to the
+//		list when the loader hands it over.
 //--------------------------------------------------------------------------------
-void Mesh_List::Erase(std::string str)
+void Mesh_List::Prefetch(const std::string& tag)
 {
-	std::list<Mesh>::const_iterator it;
+	Handle h = meshes.Intern(tag);
 
-	for(it = OList.begin(); it != OList.end(); it++)
-	{
-		if (it->tag == str)
+	if (global::LOADER == NULL 
+		|| pending.find(h) != pending.end()
+		|| meshes.Get(h) != NULL)
+		return;
+
+	Mesh* mesh = new Mesh();
+
+	pending[h] = global::LOADER->Submit(
+		[=]()
 		{
-			OList.erase(it);
-		}
-	}
+			Read(tag, *mesh);
+		},
+		[=]()
+		{
+			pending.erase(h);
+			Add(h, mesh);
+		});
+
+}	//End: Mesh_List::Prefetch()
+
+
+//--------------------------------------------------------------------------------
+//		Erase element. Its detail levels go with it.
+//--------------------------------------------------------------------------------
+void Mesh_List::Erase(const std::string& tag)
+{
+	meshes.Release(meshes.Find(tag));
 
 }	//End: Mesh_List::Erase()
 
@@ -39,30 +86,272 @@ void Mesh_List::Erase(std::string str)
 //--------------------------------------------------------------------------------
 //		Load an object into the list
 //--------------------------------------------------------------------------------
-Mesh* Mesh_List::Load(std::string tag)
+Mesh* Mesh_List::Load(Handle h)
 {
-	//Temp objects
-	std::string str;
-
-	//Add a new, empty base object to the list
-	OList.push_back(Mesh());
+	Mesh* mesh = new Mesh();
+	Read(meshes.Name(h), *mesh);
+	return Add(h, mesh);
+}	//End: Mesh_List::Load()
 
-	//Get pointer to last object
-	std::list<Mesh>::iterator it = OList.end();
-	it--;
 
-	//Load data into current base object
-	str = Mesh_List::folder + tag + "." + 
-		Mesh_List::file_extension;
-	LoadFile(str,*it);
+//--------------------------------------------------------------------------------
+//		Add a loaded mesh, with its detail levels, to the list
+//--------------------------------------------------------------------------------
+Mesh* Mesh_List::Add(Handle h, Mesh* mesh)
+{
+	const std::string& tag = meshes.Name(h);
 
 	//Ensure the file name matches the object tag in the file.
-	if (it->tag != tag)
+	if (mesh->tag != tag)
 	{
         std::cerr << "Mesh_List::Load()->object tag differs to the file name : filename : " <<
-            tag << ". tag: " << it->tag << std::endl;
-		it->tag = tag;
+            tag << ". tag: " << mesh->tag << std::endl;
+		mesh->tag = tag;
 	}
 
-	return &(*it);
-}	//End: Mesh_List::Load()
+	return meshes.Set(h, mesh);
+}	//End: Mesh_List::Add()
+
+
+//--------------------------------------------------------------------------------
+//		Read a mesh from the asset archive, its cooked file or its source.
+//		Detail levels are cooked with the mesh, and built here when it is
+//		read from source. Touches no list data, so can be called from a
+//		worker.
+//--------------------------------------------------------------------------------
+void Mesh_List::Read(const std::string& tag, Mesh& dest)
+{
+	std::string str = Mesh_List::folder + tag + "." + 
+		Mesh_List::file_extension;
+	std::string cooked = Mesh_List::folder + tag + "." +
+		Mesh_List::cooked_extension;
+
+	//Meshes in the asset archive are used as they are
+	AssetArchive::Blob blob;
+	if (global::ASSETS != NULL 
+		&& global::ASSETS->Find(AssetArchive::MESH, tag, blob)
+		&& MeshCooker::Read(blob.data, blob.size, NULL, dest))
+	{
+		return;
+	}
+
+	//Use the cooked mesh if it was made from the current source file.
+	//Without a source file, any cooked mesh will do.
+	SourceStamp stamp;
+	bool hasSource = GetSourceStamp(str, stamp);
+
+	if (!MeshCooker::Read(cooked, hasSource ? &stamp : NULL, dest))
+	{
+		LoadFile(str, dest);
+		BuildLODs(dest);
+
+		//Cook for next time
+		if (hasSource)
+			MeshCooker::Write(cooked, stamp, dest);
+	}
+
+}	//End: Mesh_List::Read()
+
+
+//--------------------------------------------------------------------------------
+//		Cook a mesh and its detail levels if its cooked file is missing or 
+//		out of date. Without a source file, an existing cooked file is used 
+//		as it is.
+//--------------------------------------------------------------------------------
+bool Mesh_List::Cook(const std::string& tag, std::string& cookedFile)
+{
+	std::string str = Mesh_List::folder + tag + "." + 
+		Mesh_List::file_extension;
+	cookedFile = Mesh_List::folder + tag + "." +
+		Mesh_List::cooked_extension;
+
+	SourceStamp stamp;
+	if (!GetSourceStamp(str, stamp))
+		return GetSourceStamp(cookedFile, stamp);
+
+	Mesh mesh;
+	if (MeshCooker::Read(cookedFile, &stamp, mesh))
+		return true;
+
+	if (!LoadFile(str, mesh))
+		return false;
+
+	BuildLODs(mesh);
+	return MeshCooker::Write(cookedFile, stamp, mesh);
+
+}	//End: Mesh_List::Cook()
+
+
+//--------------------------------------------------------------------------------
+//		Build lower detail levels. Each level merges vertices on a grid
+//		half as fine as the level before.
+//--------------------------------------------------------------------------------
+void Mesh_List::BuildLODs(Mesh& base)
+{
+	base.ClearLODs();
+
+	if (base.PList.size() <= MIN_LOD_POLYGONS || base.VList.size() == 0)
+		return;
+
+	//Largest extent of the mesh
+	Point4 lower(base.VList[0].position);
+	Point4 upper(lower);
+	for (uint32 i = 1; i < base.VList.size(); ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			lower[j] = DgMin(lower[j], base.VList[i].position[j]);
+			upper[j] = DgMax(upper[j], base.VList[i].position[j]);
+		}
+	}
+
+	float extent = DgMax(upper[0] - lower[0], upper[1] - lower[1]);
+	extent = DgMax(extent, upper[2] - lower[2]);
+	if (extent <= EPSILON)
+		return;
+
+	//Start with roughly a quarter of the vertices
+	float resolution = 0.5f * DgSqrt(float(base.VList.size()));
+	const Mesh* previous = &base;
+
+	while (base.lods.size() < MAX_LODS && resolution >= 2.0f)
+	{
+		//Build in place, copying a mesh searches for every vertex
+		Mesh* lod = new Mesh();
+
+		bool ok = Decimate(base, extent / resolution, *lod);
+		resolution *= 0.5f;
+
+		if (!ok || lod->PList.size() < MIN_LOD_POLYGONS)
+		{
+			delete lod;
+			break;
+		}
+
+		//Not enough of a reduction to be worth a level
+		if (float(lod->PList.size()) > MIN_LOD_REDUCTION * float(previous->PList.size()))
+		{
+			delete lod;
+			continue;
+		}
+
+		std::stringstream ss;
+		ss << base.tag << lod_suffix << (base.lods.size() + 1);
+		lod->tag = ss.str();
+
+		base.lods.push_back(lod);
+		previous = lod;
+	}
+
+}	//End: Mesh_List::BuildLODs()
+
+
+//--------------------------------------------------------------------------------
+//		Vertex clustering. Vertices in the same grid cell are merged, and
+//		polygons which collapse are removed. Returns false if no polygons
+//		are left.
+//--------------------------------------------------------------------------------
+bool Mesh_List::Decimate(const Mesh& src, float cellSize, Mesh& dest)
+{
+	typedef std::map<uint64, uint32> CellMap;
+
+	const float invCell = 1.0f / cellSize;
+	CellMap cells;
+	std::vector<uint32> remap(src.VList.size());
+	std::vector<Vertex> vertices;
+	std::vector<uint32> counts;
+	std::vector<Vector4> firstNormals;
+
+	//Merge vertices
+	for (uint32 i = 0; i < src.VList.size(); ++i)
+	{
+		const Vertex& v = src.VList[i];
+		uint64 key = 0;
+		for (int j = 0; j < 3; ++j)
+		{
+			int32 cell = int32(floor(v.position[j] * invCell));
+			key = (key << 21) | (uint64(cell) & 0x1FFFFF);
+		}
+
+		CellMap::iterator it = cells.find(key);
+		if (it == cells.end())
+		{
+			remap[i] = uint32(vertices.size());
+			cells[key] = remap[i];
+
+			Vertex merged;
+			merged.position = v.position;
+			merged.normal = v.normal;
+			vertices.push_back(merged);
+			firstNormals.push_back(v.normal);
+			counts.push_back(1);
+			continue;
+		}
+
+		//Accumulate
+		uint32 k = it->second;
+		remap[i] = k;
+		Vertex& merged = vertices[k];
+		for (int j = 0; j < 3; ++j)
+			merged.position[j] += v.position[j];
+		merged.normal += v.normal;
+		++counts[k];
+	}
+
+	dest.VList.resize(uint32(vertices.size()));
+	for (uint32 i = 0; i < vertices.size(); ++i)
+	{
+		Vertex& v = vertices[i];
+		float inv = 1.0f / float(counts[i]);
+		for (int j = 0; j < 3; ++j)
+			v.position[j] *= inv;
+
+		//Opposing normals can cancel, keep one of them
+		if (::IsZero(v.normal.LengthSquared()))
+			v.normal = firstNormals[i];
+		v.normal.Normalize();
+
+		dest.VList.push_back(v);
+	}
+
+	//Keep polygons whose corners are still distinct
+	const float minArea = EPSILON * cellSize * cellSize;
+	const float minArea2 = minArea * minArea;
+	std::vector<Polygon> polygons;
+	const Vertex* v0 = &src.VList[0];
+	for (uint32 i = 0; i < src.PList.size(); ++i)
+	{
+		const Polygon& p = src.PList[i];
+		uint32 a = remap[uint32(p.p0 - v0)];
+		uint32 b = remap[uint32(p.p1 - v0)];
+		uint32 c = remap[uint32(p.p2 - v0)];
+
+		if (a == b || b == c || a == c)
+			continue;
+
+		Polygon poly(p);
+		poly.p0 = &dest.VList[a];
+		poly.p1 = &dest.VList[b];
+		poly.p2 = &dest.VList[c];
+
+		//Skip polygons with next to no area before the plane normal
+		//is normalized. Scaled to the cell so it holds at any mesh size.
+		Vector4 n = Cross(poly.p1->position - poly.p0->position,
+						  poly.p2->position - poly.p0->position);
+		if (n.LengthSquared() <= minArea2)
+			continue;
+
+		poly.plane.Set(poly.p0->position, poly.p1->position, poly.p2->position);
+		polygons.push_back(poly);
+	}
+
+	dest.PList.resize(uint32(polygons.size()));
+	for (uint32 i = 0; i < polygons.size(); ++i)
+		dest.PList.push_back(polygons[i]);
+
+	dest.BuildClusters();
+	dest.OptimizeVertexCache();
+
+	return polygons.size() > 0;
+
+}	//End: Mesh_List::Decimate()
@@ -1,9 +1,11 @@
 #ifndef MESH_LIST_H
 #define MESH_LIST_H
 
-#include <list>
+#include <map>
 #include <string>
 #include "Mesh.h"
+#include "ResourceRegistry.h"
+#include "ResourceLoader.h"
 
 //--------------------------------------------------------------------------------
 //		Class for containing all Object_BASE objects
@@ -11,25 +13,47 @@
 class Mesh_List
 {
 public:
+	typedef ResourceRegistry<Mesh>::Handle Handle;
+
 	//Constructor/Destructor
 	Mesh_List() {}
 	~Mesh_List() {}
 
-	//Return
-	Mesh* operator[](std::string);
+	//Get the handle of a mesh, to look it up quickly later
+	Handle GetHandle(const std::string& tag) {return meshes.Intern(tag);}
+
+	//Return, loading the mesh if needed
+	Mesh* operator[](Handle);
+	Mesh* operator[](const std::string& tag) {return (*this)[GetHandle(tag)];}
+
+	//Load a mesh in the background, eg to prefetch a level
+	void Prefetch(const std::string&);
+
+	//Make sure the cooked file of a mesh is up to date, eg to pack it.
+	//Outputs the name of the cooked file.
+	static bool Cook(const std::string& tag, std::string& cookedFile);
 	
 	//Clear contents
-	void Erase(std::string);
-	void ClearAll() {OList.clear();}
+	void Erase(const std::string&);
+	void ClearAll() {meshes.ReleaseAll();}
 
 private:
 	//Data members
-	std::list<Mesh> OList;	//All base objects are stored here
+	ResourceRegistry<Mesh> meshes;	//All base objects are stored here
+	std::map<Handle, ResourceLoader::Ticket> pending;	//Meshes being loaded in the background
 	static const std::string folder;
 	static const std::string file_extension;
+	static const std::string cooked_extension;
+	static const std::string lod_suffix;
 
 	//Load a base object, returns pointer to last object
-	Mesh* Load(std::string);
+	Mesh* Load(Handle);
+	Mesh* Add(Handle, Mesh*);
+	static void Read(const std::string& tag, Mesh&);
+
+	//Build lower detail levels of a mesh by vertex clustering
+	static void BuildLODs(Mesh&);
+	static bool Decimate(const Mesh& src, float cellSize, Mesh& dest);
 
 	//DISALLOW Copy operations
 	Mesh_List(const Mesh_List&);
@@ -59,6 +59,9 @@ public:
 
 	void Draw(Image&) const;
 
+	//Area covered when drawn
+	const DgRect& GetBounds() const { return background.GetBox(); }
+
 private:
 
 	Text text;
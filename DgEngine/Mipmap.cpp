@@ -13,6 +13,7 @@
 //================================================================================
 
 #include "Mipmap.h"
+#include "MipmapCooker.h"
 #include "CommonMath.h"
 
 
@@ -30,6 +31,8 @@ void Mipmap::SetDefault()
 	baseW = baseH = 1;
 	baseArea = 1.0f;
 	number = 1;
+	firstResident = 0;
+	requested = NO_REQUEST;
 
 }	//End: Image::SetDefault()
 
@@ -51,8 +54,18 @@ Mipmap::Mipmap()
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
-bool Mipmap::Load(std::string filename)
+bool Mipmap::Load(std::string filename, uint32 maxSize)
 {
+	std::string cooked = filename + "." + cooked_extension;
+
+	//Use the cooked chain if it was made from the current source file.
+	//Without a source file, any cooked chain will do.
+	SourceStamp stamp;
+	bool hasSource = GetSourceStamp(filename, stamp);
+
+	if (MipmapCooker::Read(cooked, hasSource ? &stamp : NULL, *this, maxSize))
+		return true;
+
 	Image temp;
 	if (!temp.Load(filename))
 	{
@@ -62,6 +75,9 @@ bool Mipmap::Load(std::string filename)
 	
 	SetFromImage(temp);
 
+	//Cook for next time
+	MipmapCooker::Write(cooked, stamp, *this);
+
 	return true;
 
 }	//End: Mipmap::Mipmap()
@@ -88,12 +104,16 @@ void Mipmap::SetFromImage(const Image& input)
 
 	//Initiate data
 	number = 0;
+	firstResident = 0;
+	requested = NO_REQUEST;
+
+	//Each level is reduced from the level before
+	Image tempImage(input);
 
 	//Loop through, adding mipmaps
 	while (true)
 	{
 		//Add current image
-		Image tempImage(input);
 		Resize(tempImage, h, w);
 		mMipmaps.push_back(tempImage);
 
@@ -132,7 +152,8 @@ Mipmap::~Mipmap()
 //		Copy constructor
 //--------------------------------------------------------------------------------
 Mipmap::Mipmap(const Mipmap& other): baseW(other.baseW), baseH(other.baseH),
-	baseArea(other.baseArea), number(other.number), mMipmaps(other.mMipmaps)
+	baseArea(other.baseArea), number(other.number), 
+	firstResident(other.firstResident), requested(NO_REQUEST), mMipmaps(other.mMipmaps)
 {
 }	//End: Mipmap::Mipmap()
 
@@ -152,6 +173,8 @@ Mipmap& Mipmap::operator=(const Mipmap& other)
 	baseH = other.baseH;
 	baseArea = other.baseArea;
 	number = other.number;
+	firstResident = other.firstResident;
+	requested = NO_REQUEST;
 	mMipmaps = other.mMipmaps;
 
 	return *this;
@@ -170,6 +193,9 @@ const Image* Mipmap::GetImageByRef(uint8 ref) const
 	if (ref >= number)
 		return &mMipmaps[number - 1];
 
+	if (ref < firstResident)
+		return &mMipmaps[firstResident];
+
 	return &mMipmaps[ref];
 
 }	//End: Mipmap::GetDgImage()
@@ -206,8 +232,81 @@ const Image* Mipmap::GetImageByArea(float input_ratio) const
 	//Range check
 	ref = DgMin(ref, (number-1));
 
+	//Record for streaming, then use the finest level we have
+	if (ref < requested)
+		requested = ref;
+	if (ref < firstResident)
+		ref = firstResident;
+
 	//Return pointer
 	return &mMipmaps[ref];
 
 }	//End: Mipmap::GetImageByArea()
 
+
+//--------------------------------------------------------------------------------
+//	@	Mipmap::Bytes()
+//--------------------------------------------------------------------------------
+//		Memory used by the pixels of all levels
+//--------------------------------------------------------------------------------
+size_t Mipmap::Bytes() const
+{
+	size_t bytes = 0;
+	for (size_t i = 0; i < mMipmaps.size(); ++i)
+		bytes += size_t(mMipmaps[i].h()) * mMipmaps[i].pitch();
+
+	return bytes;
+
+}	//End: Mipmap::Bytes()
+
+
+//--------------------------------------------------------------------------------
+//	@	Mipmap::TakeRequestedLevel()
+//--------------------------------------------------------------------------------
+//		Finest level requested since the last call
+//--------------------------------------------------------------------------------
+uint8 Mipmap::TakeRequestedLevel() const
+{
+	uint8 result = requested;
+	requested = NO_REQUEST;
+	return result;
+
+}	//End: Mipmap::TakeRequestedLevel()
+
+
+//--------------------------------------------------------------------------------
+//	@	Mipmap::SetResidentLevels()
+//--------------------------------------------------------------------------------
+//		Swap in streamed levels
+//--------------------------------------------------------------------------------
+void Mipmap::SetResidentLevels(uint8 first, std::vector<Image>& levels)
+{
+	if (first >= firstResident || first + levels.size() != firstResident)
+		return;
+
+	for (size_t i = 0; i < levels.size(); ++i)
+		mMipmaps[first + i].Swap(levels[i]);
+
+	firstResident = first;
+
+}	//End: Mipmap::SetResidentLevels()
+
+
+//--------------------------------------------------------------------------------
+//	@	Mipmap::ReleaseLevels()
+//--------------------------------------------------------------------------------
+//		Free the pixels of fine levels
+//--------------------------------------------------------------------------------
+void Mipmap::ReleaseLevels(uint8 first)
+{
+	if (first >= number)
+		first = number - 1;
+
+	for (uint8 i = firstResident; i < first; ++i)
+		mMipmaps[i] = Image();
+
+	if (first > firstResident)
+		firstResident = first;
+
+}	//End: Mipmap::ReleaseLevels()
+
@@ -30,6 +30,8 @@
 class Mipmap
 {
 	struct Flags;
+	friend class MipmapCooker;
+	friend class RasterCapture;
 public:
 
 	//Constructor/Destructor
@@ -40,8 +42,10 @@ public:
 	Mipmap(const Mipmap&);
 	Mipmap& operator=(const Mipmap&);
 
-	//! Load Image from file
-	bool Load(std::string);
+	//! Load Image from file. A cooked copy of the mipmap chain is used
+	//! if it is up to date, otherwise one is written. If maxSize is not 0,
+	//! levels from a cooked chain larger than this are not loaded.
+	bool Load(std::string, uint32 maxSize = 0);
 
 	//! Set the mipmap from an image
 	void SetFromImage(const Image&);
@@ -55,13 +59,38 @@ public:
 	uint8 GetNumber()	const						{return number;}
 	void GetBaseSize(uint32& w, uint32& h) const	{w = baseW; h = baseH;}
 
+	//Memory used by the pixels of all levels
+	size_t Bytes() const;
+
+	//Streaming. Levels finer than the first resident level hold no pixels,
+	//and requests for them return the first resident level instead.
+	uint8 GetFirstResident() const					{return firstResident;}
+
+	//Finest level asked for by GetImageByArea() since the last call,
+	//NO_REQUEST if none.
+	uint8 TakeRequestedLevel() const;
+
+	//Make levels [first, first + levels.size()) resident. The images are 
+	//swapped in, and must continue up to the first resident level.
+	void SetResidentLevels(uint8 first, std::vector<Image>& levels);
+
+	//Release the pixels of levels finer than 'first'.
+	void ReleaseLevels(uint8 first);
+
+	static const uint8 NO_REQUEST = 0xFF;
+
 	static const Mipmap DEFAULT;
 
+	//Appended to an image file name to get its cooked file
+	static const std::string cooked_extension;
+
 private:
 	//Data members
 	uint32 baseW, baseH;	//eg. 256 x 256
 	float baseArea;
 	uint8 number;			//Number of mipmaps
+	uint8 firstResident;	//Finest level holding pixels
+	mutable uint8 requested;	//Finest level asked for
 
 	//The images
 	std::vector<Image> mMipmaps;
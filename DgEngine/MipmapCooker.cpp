@@ -0,0 +1,232 @@
+/*!
+* @file MipmapCooker.cpp
+*
+* Class definitions: MipmapCooker
+*/
+
+#include "MipmapCooker.h"
+#include "MappedFile.h"
+#include "Mipmap.h"
+#include <fstream>
+#include <vector>
+#include <iostream>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		File layout. All records are 4 byte aligned.
+//
+//		Header
+//		Levels			Level[nLevels], finest first
+//		Texels			uint32 texels of every level, one after another
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char MAGIC[4] = {'D', 'G', 'M', 'M'};
+	const uint32 VERSION = 1;
+
+	struct Header
+	{
+		char magic[4];
+		uint32 version;
+		uint64 sourceSize;
+		uint64 sourceTime;
+		uint32 nLevels;
+		uint32 nTexels;
+	};
+
+	struct Level
+	{
+		uint32 w;
+		uint32 h;
+		uint32 offset;		//First texel in the texel block
+	};
+
+	//A mipmap never has more levels than bits in its dimensions
+	const uint32 MAX_LEVELS = 33;
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	CheckFile()
+//--------------------------------------------------------------------------------
+//		Validate a cooked block of memory. Returns the level table, or NULL.
+//--------------------------------------------------------------------------------
+static const Level* CheckFile(const uint8* data, size_t size, 
+							  const SourceStamp* stamp, const Header*& header)
+{
+	if (size < sizeof(Header))
+		return NULL;
+
+	header = reinterpret_cast<const Header*>(data);
+
+	//Check header
+	if (memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION)
+		return NULL;
+
+	if (!StampMatches(stamp, header->sourceSize, header->sourceTime))
+		return NULL;
+
+	//Check size
+	size_t expected = sizeof(Header)
+		+ size_t(header->nLevels) * sizeof(Level)
+		+ size_t(header->nTexels) * sizeof(uint32);
+
+	if (header->nLevels == 0 || header->nLevels > MAX_LEVELS || size < expected)
+	{
+		std::cerr << "@MipmapCooker::Read() -> Invalid file." << std::endl;
+		return NULL;
+	}
+
+	const Level* levels = reinterpret_cast<const Level*>(data + sizeof(Header));
+
+	//Check levels lie inside the texel block
+	for (uint32 i = 0; i < header->nLevels; ++i)
+	{
+		const Level& l = levels[i];
+		if (l.w == 0 || l.h == 0 || 
+			uint64(l.offset) + uint64(l.w) * uint64(l.h) > header->nTexels)
+		{
+			std::cerr << "@MipmapCooker::Read() -> Bad level." << std::endl;
+			return NULL;
+		}
+	}
+
+	return levels;
+
+}	//End: CheckFile()
+
+
+//--------------------------------------------------------------------------------
+//	@	MipmapCooker::Read()
+//--------------------------------------------------------------------------------
+//		Load a mipmap chain from a cooked file
+//--------------------------------------------------------------------------------
+bool MipmapCooker::Read(const std::string& file, const SourceStamp* stamp, Mipmap& dest,
+						uint32 maxSize)
+{
+	MappedFile map;
+	if (!map.Open(file))
+		return false;
+
+	return Read(map.Data(), map.Size(), stamp, dest, maxSize);
+
+}	//End: MipmapCooker::Read()
+
+
+//--------------------------------------------------------------------------------
+//	@	MipmapCooker::Read()
+//--------------------------------------------------------------------------------
+//		Load a mipmap chain from a cooked block of memory
+//--------------------------------------------------------------------------------
+bool MipmapCooker::Read(const uint8* data, size_t size, const SourceStamp* stamp, Mipmap& dest,
+						uint32 maxSize)
+{
+	const Header* header;
+	const Level* levels = CheckFile(data, size, stamp, header);
+	if (levels == NULL)
+		return false;
+
+	const uint32* texels = reinterpret_cast<const uint32*>(levels + header->nLevels);
+
+	//First level to load. The last level is always loaded.
+	uint32 first = 0;
+	if (maxSize > 0)
+	{
+		while (first + 1 < header->nLevels && 
+			  (levels[first].w > maxSize || levels[first].h > maxSize))
+			++first;
+	}
+
+	//Copy levels, finer levels are left as placeholders
+	dest.mMipmaps.clear();
+	dest.mMipmaps.resize(header->nLevels);
+	for (uint32 i = first; i < header->nLevels; ++i)
+		dest.mMipmaps[i].Set(texels + levels[i].offset, levels[i].h, levels[i].w);
+
+	dest.baseW = levels[0].w;
+	dest.baseH = levels[0].h;
+	dest.baseArea = float(dest.baseW) * float(dest.baseH);
+	dest.number = uint8(header->nLevels);
+	dest.firstResident = uint8(first);
+	dest.requested = Mipmap::NO_REQUEST;
+
+	return true;
+
+}	//End: MipmapCooker::Read()
+
+
+//--------------------------------------------------------------------------------
+//	@	MipmapCooker::ReadLevels()
+//--------------------------------------------------------------------------------
+//		Load some levels of a mipmap chain from a cooked block of memory
+//--------------------------------------------------------------------------------
+bool MipmapCooker::ReadLevels(const uint8* data, size_t size, uint8 first, uint8 count,
+							  std::vector<Image>& dest)
+{
+	const Header* header;
+	const Level* levels = CheckFile(data, size, NULL, header);
+	if (levels == NULL || uint32(first) + count > header->nLevels)
+		return false;
+
+	const uint32* texels = reinterpret_cast<const uint32*>(levels + header->nLevels);
+
+	dest.clear();
+	dest.resize(count);
+	for (uint32 i = 0; i < count; ++i)
+	{
+		const Level& l = levels[first + i];
+		dest[i].Set(texels + l.offset, l.h, l.w);
+	}
+
+	return true;
+
+}	//End: MipmapCooker::ReadLevels()
+
+
+//--------------------------------------------------------------------------------
+//	@	MipmapCooker::Write()
+//--------------------------------------------------------------------------------
+//		Save a mipmap chain to a cooked file
+//--------------------------------------------------------------------------------
+bool MipmapCooker::Write(const std::string& file, const SourceStamp& stamp, const Mipmap& src)
+{
+	std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+	if (!out)
+		return false;
+
+	//Level table
+	std::vector<Level> levels(src.mMipmaps.size());
+	uint32 nTexels = 0;
+	for (size_t i = 0; i < levels.size(); ++i)
+	{
+		levels[i].w = src.mMipmaps[i].w();
+		levels[i].h = src.mMipmaps[i].h();
+		levels[i].offset = nTexels;
+		nTexels += levels[i].w * levels[i].h;
+	}
+
+	//Header
+	Header header;
+	memcpy(header.magic, MAGIC, 4);
+	header.version = VERSION;
+	header.sourceSize = stamp.size;
+	header.sourceTime = stamp.time;
+	header.nLevels = uint32(levels.size());
+	header.nTexels = nTexels;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	if (!levels.empty())
+		out.write(reinterpret_cast<const char*>(&levels[0]), levels.size() * sizeof(Level));
+
+	//Texels
+	for (size_t i = 0; i < src.mMipmaps.size(); ++i)
+	{
+		const Image& img = src.mMipmaps[i];
+		out.write(reinterpret_cast<const char*>(img.pixels()), 
+			std::streamsize(img.w()) * img.h() * sizeof(uint32));
+	}
+
+	return out.good();
+
+}	//End: MipmapCooker::Write()
@@ -0,0 +1,66 @@
+/*!
+* @file MipmapCooker.h
+*
+* Class header: MipmapCooker
+*/
+
+#ifndef MIPMAPCOOKER_H
+#define MIPMAPCOOKER_H
+
+#include <string>
+#include <stddef.h>
+#include <vector>
+#include "DgTypes.h"
+#include "CookerUtil.h"
+
+class Mipmap;
+class Image;
+
+/*!
+ * @ingroup graphics
+ *
+ * @class MipmapCooker
+ *
+ * @brief Reads and writes mipmap chains in a binary format.
+ *
+ * A cooked mipmap holds every level of the chain, finest first, as 32 bit
+ * texels in one contiguous block. Levels are stored in the layout Image 
+ * uses, so reading is a copy out of a memory-mapped file with no decoding 
+ * or resampling.
+ *
+ * The header records the size and modification time of the source image.
+ * A cooked file which does not match its source is ignored.
+ */
+class MipmapCooker
+{
+public:
+
+	/*!
+	* @brief Load a cooked mipmap.
+	*
+	* @param stamp If not NULL, the cooked file must have been made from a
+	* source with this stamp.
+	* @param maxSize If not 0, levels wider or higher than this are not
+	* loaded. They can be streamed in later with ReadLevels().
+	* @return False if the file is missing, out of date or invalid.
+	*/
+	static bool Read(const std::string& file, const SourceStamp* stamp, Mipmap& dest,
+					 uint32 maxSize = 0);
+
+	//! Load a cooked mipmap from memory, such as an asset archive.
+	static bool Read(const uint8* data, size_t size, const SourceStamp* stamp, Mipmap& dest,
+					 uint32 maxSize = 0);
+
+	//! Load levels [first, first + count) of a cooked mipmap from memory.
+	static bool ReadLevels(const uint8* data, size_t size, uint8 first, uint8 count,
+						   std::vector<Image>& dest);
+
+	//! Write a cooked mipmap.
+	static bool Write(const std::string& file, const SourceStamp& stamp, const Mipmap& src);
+
+private:
+	MipmapCooker();
+
+};
+
+#endif
@@ -19,6 +19,8 @@
 #include "ViewportEvent.h"
 #include "MessageBox.h"
 
+class CameraPath;
+
 
 //--------------------------------------------------------------------------------
 //		Overworld class
@@ -35,11 +37,21 @@ public:
 	//Input
     bool Init();
 
+	//Did the level load?
+	bool IsLoaded() const {return loaded;}
+
 	//Main loop functions
 	void HandleEvents(StateInfo&, SDL_Event&);
 	void Logic();
 	void Render();
 
+	//Advance time by a fixed step (s) each frame rather than by the timer.
+	//0 returns to the timer.
+	void SetFixedStep(float);
+
+	//Place the player along a path each frame, NULL to release.
+	void SetCameraPath(const CameraPath*);
+
 private:
 
 	//Tag
@@ -61,8 +73,20 @@ private:
 	//Change in time (s)
 	uint32 dt;
 
+	//Fixed time step (s) and steps taken
+	float fixedStep;
+	uint32 steps;
+
+	//Drives the player, if set
+	const CameraPath* cameraPath;
+
+	//Records the player's path as a CameraPath, if open
+	DgFileWriter pathRecord;
+	float recordTime;
+
 	//The game database
 	GameDatabase gameData;
+	bool loaded;
 
 	//Viewport event list
 	DgArray<ViewportEvent> viewport_events;
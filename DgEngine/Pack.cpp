@@ -0,0 +1,138 @@
+/*!
+* @file Pack.cpp
+*
+* Asset archive packing
+*/
+
+#include "Utility.h"
+#include "Dg_io.h"
+#include "SettingsParser.h"
+#include "AssetArchive.h"
+#include "ImageManager.h"
+#include "ImageManifest.h"
+#include "Mipmap.h"
+#include "Mesh_List.h"
+#include "Skybox.h"
+#include "pugixml.hpp"
+#include <string>
+#include <vector>
+#include <set>
+
+
+//--------------------------------------------------------------------------------
+//	@	AddMeshTags()
+//--------------------------------------------------------------------------------
+//		Collect the mesh tags used in a level file and its class file
+//--------------------------------------------------------------------------------
+static bool AddMeshTags(const std::string& file, std::set<std::string>& tags)
+{
+    pugi::xml_document doc;
+    if (!doc.load_file(file.c_str()))
+    {
+        std::cerr << "@RUN_PACK() -> Failed to open file: " << file << std::endl;
+        return false;
+    }
+
+    pugi::xpath_node_set meshes = doc.select_nodes("//mesh");
+    for (pugi::xpath_node_set::const_iterator it = meshes.begin(); it != meshes.end(); ++it)
+    {
+        tags.insert(it->node().child_value());
+    }
+
+    pugi::xml_node classFile = doc.document_element().child("classFile");
+    if (classFile)
+    {
+        return AddMeshTags(classFile.child_value(), tags);
+    }
+
+    return true;
+
+}	//End: AddMeshTags()
+
+
+//--------------------------------------------------------------------------------
+//	@	RUN_PACK()
+//--------------------------------------------------------------------------------
+//		Cook assets and pack them into an archive
+//--------------------------------------------------------------------------------
+/*!
+ * Assets which cannot be cooked are left out, and are reported.
+ */
+int RUN_PACK(const SettingsParser& options)
+{
+    std::string file, level("gamma.xml");
+    options.GetValue("pack", file);
+    options.GetValue("level", level);
+
+    std::vector<AssetArchive::Source> sources;
+    uint32 nImages = 0, nMeshes = 0, nSkipped = 0;
+
+    //Every image in the manifest
+    ImageManifest manifest;
+    if (!manifest.ReadCache(ImageManager::s_manifestPath) &&
+        !manifest.Parse(ImageManager::s_manifestPath))
+    {
+        std::cerr << "@RUN_PACK() -> Could not load image manifest: "
+          << ImageManager::s_manifestPath << std::endl;
+        return 1;
+    }
+
+    std::vector<uint32> ids;
+    manifest.GetIDs(ids);
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        //Loading cooks the chain if needed
+        std::string path;
+        Mipmap mipmap;
+        if (!manifest.Find(ids[i], path) || !mipmap.Load(path))
+        {
+            std::cerr << "@RUN_PACK() -> Skipping image " << ids[i] << ": " << path << std::endl;
+            ++nSkipped;
+            continue;
+        }
+
+        AssetArchive::Source source;
+        source.type = AssetArchive::MIPMAP;
+        source.id = ids[i];
+        source.file = path + "." + Mipmap::cooked_extension;
+        sources.push_back(source);
+        ++nImages;
+    }
+
+    //Meshes used by the level, and the skybox
+    std::set<std::string> tags;
+    tags.insert(Skybox::obj_file);
+    if (!AddMeshTags(level, tags))
+    {
+        return 1;
+    }
+
+    for (std::set<std::string>::const_iterator it = tags.begin(); it != tags.end(); ++it)
+    {
+        AssetArchive::Source source;
+        if (!Mesh_List::Cook(*it, source.file))
+        {
+            std::cerr << "@RUN_PACK() -> Skipping mesh: " << *it << std::endl;
+            ++nSkipped;
+            continue;
+        }
+
+        source.type = AssetArchive::MESH;
+        source.id = 0;
+        source.name = *it;
+        sources.push_back(source);
+        ++nMeshes;
+    }
+
+    if (!AssetArchive::Write(file, sources))
+    {
+        std::cerr << "@RUN_PACK() -> Failed to write archive: " << file << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << nImages << " images and " << nMeshes << " meshes into "
+        << file << ", skipped " << nSkipped << std::endl;
+
+    return 0;
+
+}	//End: RUN_PACK()
@@ -26,6 +26,7 @@
  */
 class ParticleAlphaTemplate
 {
+	friend class RasterCapture;
 public:
 
 	//! The dimension of all alpha templates.
@@ -41,6 +41,11 @@ public:
 	PointLight(const PointLight& other): PointLightBASE(other), sphere(other.sphere) {}
 	PointLight& operator= (const PointLight&);
 
+	//! Compares color, intensity and bounds.
+	bool operator== (const PointLight& other) const
+	{return Light::operator==(other) && sphere == other.sphere;}
+	bool operator!= (const PointLight& other) const {return !(*this == other);}
+
 	/*!
 	* @brief Creates a deep copy of a derived object.
 	*
@@ -54,6 +59,12 @@ public:
 	//! Set the position of the light
 	void PointLight::SetPosition(const Point4&);
 
+	//! Position of the light
+	const Point4& Position() const {return sphere.Center();}
+
+	//! Volume the light reaches
+	const Sphere& GetSphere() const {return sphere;}
+
 	//! Adjusts intensity.
 	void Transform(const VQS&);
 
@@ -0,0 +1,192 @@
+/*!
+* @file Profiler.cpp
+*
+* Class definitions: Profiler
+*/
+
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		Statics
+//--------------------------------------------------------------------------------
+bool Profiler::running = false;
+int64 Profiler::frameStart = 0;
+int64 Profiler::current[Profiler::N_STAGES];
+std::vector<int64> Profiler::frameTimes;
+std::vector<int64> Profiler::stageTimes[Profiler::N_STAGES];
+
+
+//--------------------------------------------------------------------------------
+//		Helpers
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char* STAGE_NAMES[Profiler::N_STAGES] =
+	{
+		"SYSTEM_AssignViewports",
+		"SYSTEM_CameraControl",
+		"SYSTEM_Move",
+		"SYSTEM_UpdatePositionHierarchies",
+		"SYSTEM_UpdatePhysics",
+		"SYSTEM_UpdateLights",
+		"SYSTEM_AddLights",
+		"SYSTEM_UpdateParticleEmitters",
+		"SYSTEM_CameraPost",
+		"SYSTEM_Add_Entities",
+		"SYSTEM_Add_Skyboxes",
+		"SYSTEM_Render",
+		"cull",
+		"lighting",
+		"clip",
+		"sort",
+		"rasterize",
+		"compile",
+		"present"
+	};
+
+	double ToMS(int64 ns)
+	{
+		return double(ns) / 1.0e6;
+	}
+
+	//Nearest rank percentile of sorted values
+	int64 Percentile(const std::vector<int64>& sorted, uint32 p)
+	{
+		if (sorted.empty())
+			return 0;
+
+		size_t rank = (sorted.size() * p + 99) / 100;
+		if (rank == 0)
+			rank = 1;
+		return sorted[rank - 1];
+	}
+
+	void WriteSummary(DgWriter& out, std::vector<int64> times, const char* indent)
+	{
+		std::sort(times.begin(), times.end());
+
+		int64 total = 0;
+		for (size_t i = 0; i < times.size(); ++i)
+			total += times[i];
+
+		double mean = times.empty() ? 0.0 : ToMS(total) / double(times.size());
+
+		out << "{\n"
+			<< indent << "  \"mean\": " << mean << ",\n"
+			<< indent << "  \"min\": " << ToMS(times.empty() ? 0 : times.front()) << ",\n"
+			<< indent << "  \"p50\": " << ToMS(Percentile(times, 50)) << ",\n"
+			<< indent << "  \"p90\": " << ToMS(Percentile(times, 90)) << ",\n"
+			<< indent << "  \"p95\": " << ToMS(Percentile(times, 95)) << ",\n"
+			<< indent << "  \"p99\": " << ToMS(Percentile(times, 99)) << ",\n"
+			<< indent << "  \"max\": " << ToMS(times.empty() ? 0 : times.back()) << ",\n"
+			<< indent << "  \"total\": " << ToMS(total) << "\n"
+			<< indent << "}";
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::Start()
+//--------------------------------------------------------------------------------
+//		Clear all records and start profiling
+//--------------------------------------------------------------------------------
+void Profiler::Start()
+{
+	frameTimes.clear();
+	for (uint32 i = 0; i < N_STAGES; ++i)
+		stageTimes[i].clear();
+
+	memset(current, 0, sizeof(current));
+	frameStart = Now();
+	running = true;
+
+}	//End: Profiler::Start()
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::BeginFrame()
+//--------------------------------------------------------------------------------
+//		Start timing a frame
+//--------------------------------------------------------------------------------
+void Profiler::BeginFrame()
+{
+	memset(current, 0, sizeof(current));
+	frameStart = Now();
+
+}	//End: Profiler::BeginFrame()
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::EndFrame()
+//--------------------------------------------------------------------------------
+//		Record the frame
+//--------------------------------------------------------------------------------
+void Profiler::EndFrame()
+{
+	if (!running)
+		return;
+
+	frameTimes.push_back(Now() - frameStart);
+	for (uint32 i = 0; i < N_STAGES; ++i)
+		stageTimes[i].push_back(current[i]);
+
+}	//End: Profiler::EndFrame()
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::Now()
+//--------------------------------------------------------------------------------
+//		Current time in nanoseconds
+//--------------------------------------------------------------------------------
+int64 Profiler::Now()
+{
+	return int64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+
+}	//End: Profiler::Now()
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::Name()
+//--------------------------------------------------------------------------------
+//		Name of a stage
+//--------------------------------------------------------------------------------
+const char* Profiler::Name(Stage s)
+{
+	return STAGE_NAMES[s];
+
+}	//End: Profiler::Name()
+
+
+//--------------------------------------------------------------------------------
+//	@	Profiler::WriteJSON()
+//--------------------------------------------------------------------------------
+//		Write a summary of the recorded frames
+//--------------------------------------------------------------------------------
+void Profiler::WriteJSON(DgWriter& out)
+{
+	std::streamsize precision = out.precision(4);
+	std::ios::fmtflags flags = out.setf(std::ios::fixed, std::ios::floatfield);
+
+	out << "  \"frame_ms\": ";
+	WriteSummary(out, frameTimes, "  ");
+	out << ",\n  \"stages_ms\": {\n";
+
+	for (uint32 i = 0; i < N_STAGES; ++i)
+	{
+		out << "    \"" << STAGE_NAMES[i] << "\": ";
+		WriteSummary(out, stageTimes[i], "    ");
+		out << ((i + 1 < N_STAGES) ? ",\n" : "\n");
+	}
+
+	out << "  }";
+
+	out.precision(precision);
+	out.flags(flags);
+
+}	//End: Profiler::WriteJSON()
@@ -0,0 +1,121 @@
+/*!
+* @file Profiler.h
+*
+* Class header: Profiler, ProfileScope
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <vector>
+#include "Dg_io.h"
+#include "DgTypes.h"
+
+/*!
+ * @ingroup utility_system
+ *
+ * @class Profiler
+ *
+ * @brief Records the time spent in each stage of a frame.
+ *
+ * Stages are timed with ProfileScope. Times are summed over a frame, and
+ * kept for every frame between Start() and Stop(). Stages may be nested:
+ * the cull, lighting and clip stages run within SYSTEM_Add_Entities, the
+ * sort and rasterize stages within SYSTEM_Render.
+ *
+ * Only the main thread may be profiled. When the profiler is not running a
+ * ProfileScope costs a single test.
+ */
+class Profiler
+{
+public:
+
+	enum Stage
+	{
+		ASSIGN_VIEWPORTS,
+		CAMERA_CONTROL,
+		MOVE,
+		POSITION_HIERARCHIES,
+		PHYSICS,
+		UPDATE_LIGHTS,
+		ADD_LIGHTS,
+		PARTICLE_EMITTERS,
+		CAMERA_POST,
+		ADD_ENTITIES,
+		ADD_SKYBOXES,
+		RENDER,
+		CULL,
+		LIGHTING,
+		CLIP,
+		SORT,
+		RASTERIZE,
+		COMPILE,
+		PRESENT,
+		N_STAGES
+	};
+
+	//! Clear all records and start profiling.
+	static void Start();
+	static void Stop() {running = false;}
+	static bool IsRunning() {return running;}
+
+	//! Mark the start and end of a frame.
+	static void BeginFrame();
+	static void EndFrame();
+
+	//! Frames recorded.
+	static uint32 Frames() {return uint32(frameTimes.size());}
+
+	//! Current time (ns).
+	static int64 Now();
+
+	//! Add time to a stage of the current frame.
+	static void Add(Stage s, int64 ns) {current[s] += ns;}
+
+	//! Name of a stage.
+	static const char* Name(Stage);
+
+	//! Write a summary of the recorded frames as the members of a JSON
+	//! object: "frame_ms" and "stages_ms". Times are in milliseconds.
+	static void WriteJSON(DgWriter&);
+
+private:
+	//Data members
+	static bool running;
+	static int64 frameStart;
+	static int64 current[N_STAGES];
+	static std::vector<int64> frameTimes;
+	static std::vector<int64> stageTimes[N_STAGES];
+};
+
+
+/*!
+ * @ingroup utility_system
+ *
+ * @class ProfileScope
+ *
+ * @brief Adds the time between its construction and destruction to a stage.
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(Profiler::Stage s):
+		stage(s), start(Profiler::IsRunning() ? Profiler::Now() : -1) {}
+
+	~ProfileScope()
+	{
+		if (start >= 0)
+			Profiler::Add(stage, Profiler::Now() - start);
+	}
+
+private:
+	Profiler::Stage stage;
+	int64 start;
+
+private:
+	//DISALLOW Copy operations
+	ProfileScope(const ProfileScope&);
+	ProfileScope& operator=(const ProfileScope&);
+};
+
+#endif
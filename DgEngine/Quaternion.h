@@ -71,6 +71,10 @@ public:
     // accessors
     inline float& operator[]( uint32 i )         { return (&x)[i]; }
     inline float operator[]( uint32 i ) const    { return (&x)[i]; }
+	inline float W() const { return w; }
+	inline float X() const { return x; }
+	inline float Y() const { return y; }
+	inline float Z() const { return z; }
 
     float Magnitude() const;
     float Norm() const;
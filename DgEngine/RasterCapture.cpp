@@ -0,0 +1,702 @@
+/*!
+* @file RasterCapture.cpp
+*
+* Class definitions: RasterCapture
+*/
+
+#include "RasterCapture.h"
+#include "Rasterizer.h"
+#include <fstream>
+#include <iostream>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------
+//		File layout. All records are 4 byte aligned.
+//
+//		Header
+//		Materials		MaterialRecord[nMaterials]
+//		Mipmaps			For each: MipmapRecord, LevelRecord[nLevels], then the
+//						uint32 texels of each resident level
+//		Images			For each: LevelRecord, then uint32 texels
+//		Templates		uint8[SIZE * SIZE] for each
+//		Polygons		PolygonRecord[nPolygons]
+//		Skyboxes		SkyboxRecord[nSkyboxes]
+//		Particles		ParticleRecord[nParticles]
+//		Commands		Command[nCommands], in draw order
+//--------------------------------------------------------------------------------
+namespace
+{
+	const char MAGIC[4] = {'D', 'G', 'R', 'S'};
+	const uint32 VERSION = 1;
+
+	struct Header
+	{
+		char magic[4];
+		uint32 version;
+		uint32 width;
+		uint32 height;
+		uint32 nMaterials;
+		uint32 nMipmaps;
+		uint32 nImages;
+		uint32 nTemplates;
+		uint32 nPolygons;
+		uint32 nSkyboxes;
+		uint32 nParticles;
+		uint32 nCommands;
+	};
+
+	enum MaterialFlags
+	{
+		MASTER		= 1 << 0,
+		ALPHA_PP	= 1 << 1,
+		ALPHA_M		= 1 << 2,
+		EMISSION	= 1 << 3,
+		REFLECTION	= 1 << 4,
+		DOUBLESIDED	= 1 << 5
+	};
+
+	struct MaterialRecord
+	{
+		uint32 flags;
+		uint32 alpha;
+	};
+
+	struct MipmapRecord
+	{
+		uint32 nLevels;
+		uint32 firstResident;
+	};
+
+	struct LevelRecord
+	{
+		uint32 w;
+		uint32 h;
+	};
+
+	struct VertexRecord
+	{
+		float pos[4];
+		float clr[3];
+		float uv[2];
+	};
+
+	struct PolygonRecord
+	{
+		VertexRecord v[3];
+		int32 materials;
+		int32 mipmap;
+	};
+
+	struct SkyboxRecord
+	{
+		VertexRecord v[3];
+		int32 image;
+	};
+
+	struct ParticleRecord
+	{
+		float pos[4];
+		float radius;
+		uint32 color;
+		int32 alphaTemplate;
+	};
+
+	//Sanity limits on read
+	const uint32 MAX_LEVELS = 33;
+	const uint32 MAX_DIMENSION = 1 << 16;
+
+
+	//--------------------------------------------------------------------------------
+	//		Raw reads and writes
+	//--------------------------------------------------------------------------------
+	template<typename T>
+	void Put(std::ofstream& out, const T& t)
+	{
+		out.write(reinterpret_cast<const char*>(&t), sizeof(T));
+	}
+
+	template<typename T>
+	bool Get(std::ifstream& in, T& t)
+	{
+		return bool(in.read(reinterpret_cast<char*>(&t), sizeof(T)));
+	}
+
+	//Are there bytes left for count records of a size?
+	bool Fits(std::ifstream& in, uint64 end, uint64 count, uint64 size)
+	{
+		std::streamoff pos = in.tellg();
+		if (pos < 0 || uint64(pos) > end)
+			return false;
+
+		return count <= (end - uint64(pos)) / size;
+	}
+
+	void PutPixels(std::ofstream& out, const Image& img)
+	{
+		out.write(reinterpret_cast<const char*>(img.pixels()),
+			std::streamsize(img.w()) * img.h() * sizeof(uint32));
+	}
+
+	bool GetImage(std::ifstream& in, uint64 end, uint32 w, uint32 h, Image& dest)
+	{
+		if (w == 0 || h == 0 || w > MAX_DIMENSION || h > MAX_DIMENSION
+			|| !Fits(in, end, uint64(w) * h, sizeof(uint32_t)))
+			return false;
+
+		std::vector<uint32_t> texels(size_t(w) * h);
+		if (!in.read(reinterpret_cast<char*>(&texels[0]),
+			std::streamsize(texels.size() * sizeof(uint32_t))))
+			return false;
+
+		dest.Set(&texels[0], h, w);
+		return true;
+	}
+
+	void ToRecord(const Vertex_RASTER& v, VertexRecord& r)
+	{
+		r.pos[0] = v.pos.X();
+		r.pos[1] = v.pos.Y();
+		r.pos[2] = v.pos.Z();
+		r.pos[3] = v.pos.W();
+		r.clr[0] = v.clr[0];
+		r.clr[1] = v.clr[1];
+		r.clr[2] = v.clr[2];
+		r.uv[0] = v.uv.x;
+		r.uv[1] = v.uv.y;
+	}
+
+	void FromRecord(const VertexRecord& r, Vertex_RASTER& v)
+	{
+		v.pos.X() = r.pos[0];
+		v.pos.Y() = r.pos[1];
+		v.pos.Z() = r.pos[2];
+		v.pos.W() = r.pos[3];
+		v.clr.Set(r.clr[0], r.clr[1], r.clr[2]);
+		v.uv.Set(r.uv[0], r.uv[1]);
+	}
+
+	//Screen area of a triangle
+	double Area(const Vertex_RASTER& a, const Vertex_RASTER& b, const Vertex_RASTER& c)
+	{
+		double cross = double(b.pos.X() - a.pos.X()) * double(c.pos.Y() - a.pos.Y())
+			- double(c.pos.X() - a.pos.X()) * double(b.pos.Y() - a.pos.Y());
+		return (cross < 0.0) ? -cross * 0.5 : cross * 0.5;
+	}
+}
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Clear()
+//--------------------------------------------------------------------------------
+//		Empty the capture
+//--------------------------------------------------------------------------------
+void RasterCapture::Clear(uint32 w, uint32 h)
+{
+	width = w;
+	height = h;
+
+	materials.clear();
+	mipmaps.clear();
+	images.clear();
+	alphaTemplates.clear();
+
+	polygons.clear();
+	skyboxes.clear();
+	particles.clear();
+	commands.clear();
+
+	polygonMaterials.clear();
+	polygonMipmaps.clear();
+	skyboxImages.clear();
+	particleTemplates.clear();
+
+	resourceIndex.clear();
+
+}	//End: RasterCapture::Clear()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Store()
+//--------------------------------------------------------------------------------
+//		Copy a resource the first time it is seen. Returns its index.
+//--------------------------------------------------------------------------------
+template<typename T>
+int32 RasterCapture::Store(const T* resource, std::vector<T>& dest)
+{
+	if (resource == NULL)
+		return -1;
+
+	std::map<const void*, uint32>::const_iterator it = resourceIndex.find(resource);
+	if (it != resourceIndex.end())
+		return int32(it->second);
+
+	uint32 index = uint32(dest.size());
+	dest.push_back(*resource);
+	resourceIndex[resource] = index;
+	return int32(index);
+
+}	//End: RasterCapture::Store()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Add()
+//--------------------------------------------------------------------------------
+//		Add a polygon
+//--------------------------------------------------------------------------------
+void RasterCapture::Add(const Polygon_RASTER& p)
+{
+	Command c = {POLYGON, uint32(polygons.size())};
+	commands.push_back(c);
+	polygons.push_back(p);
+	polygonMaterials.push_back(Store(p.materials, materials));
+	polygonMipmaps.push_back(Store(p.mipmap, mipmaps));
+
+}	//End: RasterCapture::Add()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Add()
+//--------------------------------------------------------------------------------
+//		Add a skybox polygon
+//--------------------------------------------------------------------------------
+void RasterCapture::Add(const Polygon_RASTER_SB& p)
+{
+	Command c = {SKYBOX, uint32(skyboxes.size())};
+	commands.push_back(c);
+	skyboxes.push_back(p);
+	skyboxImages.push_back(Store(p.image, images));
+
+}	//End: RasterCapture::Add()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Add()
+//--------------------------------------------------------------------------------
+//		Add a particle
+//--------------------------------------------------------------------------------
+void RasterCapture::Add(const Particle_RASTER& p)
+{
+	Command c = {PARTICLE, uint32(particles.size())};
+	commands.push_back(c);
+	particles.push_back(p);
+	particleTemplates.push_back(Store(p.alphaTemplate, alphaTemplates));
+
+}	//End: RasterCapture::Add()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Link()
+//--------------------------------------------------------------------------------
+//		Point the items at the resources held
+//--------------------------------------------------------------------------------
+void RasterCapture::Link()
+{
+	for (size_t i = 0; i < polygons.size(); ++i)
+	{
+		int32 m = polygonMaterials[i];
+		int32 mm = polygonMipmaps[i];
+		polygons[i].materials = (m < 0) ? NULL : &materials[m];
+		polygons[i].mipmap = (mm < 0) ? NULL : &mipmaps[mm];
+	}
+
+	for (size_t i = 0; i < skyboxes.size(); ++i)
+	{
+		int32 img = skyboxImages[i];
+		skyboxes[i].image = (img < 0) ? NULL : &images[img];
+	}
+
+	for (size_t i = 0; i < particles.size(); ++i)
+	{
+		int32 t = particleTemplates[i];
+		particles[i].alphaTemplate = (t < 0) ? NULL : &alphaTemplates[t];
+	}
+
+}	//End: RasterCapture::Link()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Replay()
+//--------------------------------------------------------------------------------
+//		Draw everything, in order
+//--------------------------------------------------------------------------------
+void RasterCapture::Replay(Rasterizer& output) const
+{
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		const Command& c = commands[i];
+		switch (c.type)
+		{
+		case POLYGON:
+			output.DrawPolygon(polygons[c.index]);
+			break;
+		case SKYBOX:
+			output.DrawSkyBoxPolygon(skyboxes[c.index]);
+			break;
+		case PARTICLE:
+			output.DrawParticle(particles[c.index]);
+			break;
+		}
+	}
+
+}	//End: RasterCapture::Replay()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Pixels()
+//--------------------------------------------------------------------------------
+//		Screen area of everything drawn
+//--------------------------------------------------------------------------------
+uint64 RasterCapture::Pixels() const
+{
+	double area = 0.0;
+
+	for (size_t i = 0; i < polygons.size(); ++i)
+		area += Area(polygons[i].p0, polygons[i].p1, polygons[i].p2);
+
+	for (size_t i = 0; i < skyboxes.size(); ++i)
+		area += Area(skyboxes[i].p0, skyboxes[i].p1, skyboxes[i].p2);
+
+	//Particles are drawn as squares, clipped to the image
+	for (size_t i = 0; i < particles.size(); ++i)
+	{
+		const Particle_RASTER& p = particles[i];
+		float x0 = p.position.X() - p.radius;
+		float x1 = p.position.X() + p.radius;
+		float y0 = p.position.Y() - p.radius;
+		float y1 = p.position.Y() + p.radius;
+
+		if (x0 < 0.0f) x0 = 0.0f;
+		if (y0 < 0.0f) y0 = 0.0f;
+		if (x1 > float(width)) x1 = float(width);
+		if (y1 > float(height)) y1 = float(height);
+
+		if (x1 > x0 && y1 > y0)
+			area += double(x1 - x0) * double(y1 - y0);
+	}
+
+	return uint64(area + 0.5);
+
+}	//End: RasterCapture::Pixels()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Write()
+//--------------------------------------------------------------------------------
+//		Save to a binary file
+//--------------------------------------------------------------------------------
+bool RasterCapture::Write(const std::string& file) const
+{
+	std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+	if (!out)
+	{
+		std::cerr << "@RasterCapture::Write() -> Failed to open " << file << std::endl;
+		return false;
+	}
+
+	Header header;
+	memcpy(header.magic, MAGIC, 4);
+	header.version = VERSION;
+	header.width = width;
+	header.height = height;
+	header.nMaterials = uint32(materials.size());
+	header.nMipmaps = uint32(mipmaps.size());
+	header.nImages = uint32(images.size());
+	header.nTemplates = uint32(alphaTemplates.size());
+	header.nPolygons = uint32(polygons.size());
+	header.nSkyboxes = uint32(skyboxes.size());
+	header.nParticles = uint32(particles.size());
+	header.nCommands = uint32(commands.size());
+	Put(out, header);
+
+	//Materials
+	for (size_t i = 0; i < materials.size(); ++i)
+	{
+		const Materials& m = materials[i];
+		MaterialRecord r;
+		r.flags = (m.IsMasterOn() ? MASTER : 0)
+			| (m.IsAlphaPP() ? ALPHA_PP : 0)
+			| (m.IsAlphaMaster() ? ALPHA_M : 0)
+			| (m.IsEmissive() ? EMISSION : 0)
+			| (m.IsReflective() ? REFLECTION : 0)
+			| (m.IsDoubleSided() ? DOUBLESIDED : 0);
+		r.alpha = m.GetAlpha();
+		Put(out, r);
+	}
+
+	//Mipmaps, resident levels only
+	for (size_t i = 0; i < mipmaps.size(); ++i)
+	{
+		const Mipmap& mm = mipmaps[i];
+		MipmapRecord r = {uint32(mm.mMipmaps.size()), mm.firstResident};
+		Put(out, r);
+
+		for (size_t j = 0; j < mm.mMipmaps.size(); ++j)
+		{
+			//Sizes of levels without pixels are taken from the base size
+			LevelRecord l = {mm.baseW >> j, mm.baseH >> j};
+			if (l.w == 0) l.w = 1;
+			if (l.h == 0) l.h = 1;
+			if (j >= mm.firstResident)
+			{
+				l.w = mm.mMipmaps[j].w();
+				l.h = mm.mMipmaps[j].h();
+			}
+			Put(out, l);
+		}
+
+		for (size_t j = mm.firstResident; j < mm.mMipmaps.size(); ++j)
+			PutPixels(out, mm.mMipmaps[j]);
+	}
+
+	//Skybox images
+	for (size_t i = 0; i < images.size(); ++i)
+	{
+		LevelRecord l = {images[i].w(), images[i].h()};
+		Put(out, l);
+		PutPixels(out, images[i]);
+	}
+
+	//Particle alpha templates
+	for (size_t i = 0; i < alphaTemplates.size(); ++i)
+		out.write(reinterpret_cast<const char*>(alphaTemplates[i].data), sizeof(alphaTemplates[i].data));
+
+	//Items
+	for (size_t i = 0; i < polygons.size(); ++i)
+	{
+		PolygonRecord r;
+		ToRecord(polygons[i].p0, r.v[0]);
+		ToRecord(polygons[i].p1, r.v[1]);
+		ToRecord(polygons[i].p2, r.v[2]);
+		r.materials = polygonMaterials[i];
+		r.mipmap = polygonMipmaps[i];
+		Put(out, r);
+	}
+
+	for (size_t i = 0; i < skyboxes.size(); ++i)
+	{
+		SkyboxRecord r;
+		ToRecord(skyboxes[i].p0, r.v[0]);
+		ToRecord(skyboxes[i].p1, r.v[1]);
+		ToRecord(skyboxes[i].p2, r.v[2]);
+		r.image = skyboxImages[i];
+		Put(out, r);
+	}
+
+	for (size_t i = 0; i < particles.size(); ++i)
+	{
+		const Particle_RASTER& p = particles[i];
+		ParticleRecord r;
+		r.pos[0] = p.position.X();
+		r.pos[1] = p.position.Y();
+		r.pos[2] = p.position.Z();
+		r.pos[3] = p.position.W();
+		r.radius = p.radius;
+		r.color = p.color;
+		r.alphaTemplate = particleTemplates[i];
+		Put(out, r);
+	}
+
+	for (size_t i = 0; i < commands.size(); ++i)
+		Put(out, commands[i]);
+
+	return out.good();
+
+}	//End: RasterCapture::Write()
+
+
+//--------------------------------------------------------------------------------
+//	@	RasterCapture::Read()
+//--------------------------------------------------------------------------------
+//		Load from a binary file
+//--------------------------------------------------------------------------------
+bool RasterCapture::Read(const std::string& file)
+{
+	std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+	if (!in)
+	{
+		std::cerr << "@RasterCapture::Read() -> Failed to open " << file << std::endl;
+		return false;
+	}
+
+	//Counts are checked against what is left of the file before any space
+	//is made for them
+	in.seekg(0, std::ios::end);
+	std::streamoff size = in.tellg();
+	in.seekg(0, std::ios::beg);
+	uint64 end = (size < 0) ? 0 : uint64(size);
+
+	Header header;
+	if (!Get(in, header) || memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION
+		|| header.width > MAX_DIMENSION || header.height > MAX_DIMENSION)
+	{
+		std::cerr << "@RasterCapture::Read() -> Not a raster capture: " << file << std::endl;
+		return false;
+	}
+
+	Clear(header.width, header.height);
+	bool ok = Fits(in, end, header.nMaterials, sizeof(MaterialRecord));
+
+	//Materials
+	if (ok)
+		materials.resize(header.nMaterials);
+	for (uint32 i = 0; ok && i < header.nMaterials; ++i)
+	{
+		MaterialRecord r;
+		ok = Get(in, r);
+
+		Materials& m = materials[i];
+		m.SwitchMaster((r.flags & MASTER) != 0);
+		m.SwitchAlphaPP((r.flags & ALPHA_PP) != 0);
+		m.SwitchAlphaM((r.flags & ALPHA_M) != 0);
+		m.SwitchEmission((r.flags & EMISSION) != 0);
+		m.SwitchReflection((r.flags & REFLECTION) != 0);
+		m.SwitchDoubleSided((r.flags & DOUBLESIDED) != 0);
+		m.SetAlpha(double(r.alpha) / 65536.0);
+	}
+
+	//Mipmaps, each at least one level of one texel
+	ok = ok && Fits(in, end, header.nMipmaps, 
+		sizeof(MipmapRecord) + sizeof(LevelRecord) + sizeof(uint32_t));
+	if (ok)
+		mipmaps.resize(header.nMipmaps);
+	for (uint32 i = 0; ok && i < header.nMipmaps; ++i)
+	{
+		MipmapRecord r;
+		ok = Get(in, r) && r.nLevels > 0 && r.nLevels <= MAX_LEVELS && r.firstResident < r.nLevels;
+		if (!ok)
+			break;
+
+		//Each level halves the one before, down to 1
+		std::vector<LevelRecord> levels(r.nLevels);
+		for (uint32 j = 0; ok && j < r.nLevels; ++j)
+		{
+			ok = Get(in, levels[j]);
+			if (j == 0)
+			{
+				ok = ok && levels[0].w > 0 && levels[0].h > 0
+					&& levels[0].w <= MAX_DIMENSION && levels[0].h <= MAX_DIMENSION;
+			}
+			else
+			{
+				uint32 w = levels[0].w >> j, h = levels[0].h >> j;
+				ok = ok && levels[j].w == (w > 0 ? w : 1) && levels[j].h == (h > 0 ? h : 1);
+			}
+		}
+		if (!ok)
+			break;
+
+		Mipmap& mm = mipmaps[i];
+		mm.mMipmaps.clear();
+		mm.mMipmaps.resize(r.nLevels);
+		for (uint32 j = r.firstResident; ok && j < r.nLevels; ++j)
+			ok = GetImage(in, end, levels[j].w, levels[j].h, mm.mMipmaps[j]);
+
+		mm.baseW = levels[0].w;
+		mm.baseH = levels[0].h;
+		mm.baseArea = float(mm.baseW) * float(mm.baseH);
+		mm.number = uint8(r.nLevels);
+		mm.firstResident = uint8(r.firstResident);
+		mm.requested = Mipmap::NO_REQUEST;
+	}
+
+	//Skybox images
+	ok = ok && Fits(in, end, header.nImages, sizeof(LevelRecord) + sizeof(uint32_t));
+	if (ok)
+		images.resize(header.nImages);
+	for (uint32 i = 0; ok && i < header.nImages; ++i)
+	{
+		LevelRecord l;
+		ok = Get(in, l) && GetImage(in, end, l.w, l.h, images[i]);
+	}
+
+	//Particle alpha templates
+	ok = ok && Fits(in, end, header.nTemplates, ParticleAlphaTemplate::SIZE * ParticleAlphaTemplate::SIZE);
+	if (ok)
+		alphaTemplates.resize(header.nTemplates);
+	for (uint32 i = 0; ok && i < header.nTemplates; ++i)
+		ok = bool(in.read(reinterpret_cast<char*>(alphaTemplates[i].data), sizeof(alphaTemplates[i].data)));
+
+	//Items
+	ok = ok && Fits(in, end, header.nPolygons, sizeof(PolygonRecord));
+	if (ok)
+	{
+		polygons.resize(header.nPolygons);
+		polygonMaterials.resize(header.nPolygons);
+		polygonMipmaps.resize(header.nPolygons);
+	}
+	for (uint32 i = 0; ok && i < header.nPolygons; ++i)
+	{
+		PolygonRecord r;
+		ok = Get(in, r)
+			&& r.materials < int32(header.nMaterials)
+			&& r.mipmap < int32(header.nMipmaps);
+
+		FromRecord(r.v[0], polygons[i].p0);
+		FromRecord(r.v[1], polygons[i].p1);
+		FromRecord(r.v[2], polygons[i].p2);
+		polygonMaterials[i] = r.materials;
+		polygonMipmaps[i] = r.mipmap;
+	}
+
+	ok = ok && Fits(in, end, header.nSkyboxes, sizeof(SkyboxRecord));
+	if (ok)
+	{
+		skyboxes.resize(header.nSkyboxes);
+		skyboxImages.resize(header.nSkyboxes);
+	}
+	for (uint32 i = 0; ok && i < header.nSkyboxes; ++i)
+	{
+		SkyboxRecord r;
+		ok = Get(in, r) && r.image < int32(header.nImages);
+
+		FromRecord(r.v[0], skyboxes[i].p0);
+		FromRecord(r.v[1], skyboxes[i].p1);
+		FromRecord(r.v[2], skyboxes[i].p2);
+		skyboxImages[i] = r.image;
+	}
+
+	ok = ok && Fits(in, end, header.nParticles, sizeof(ParticleRecord));
+	if (ok)
+	{
+		particles.resize(header.nParticles);
+		particleTemplates.resize(header.nParticles);
+	}
+	for (uint32 i = 0; ok && i < header.nParticles; ++i)
+	{
+		ParticleRecord r;
+		ok = Get(in, r) && r.alphaTemplate >= 0 && r.alphaTemplate < int32(header.nTemplates);
+
+		Particle_RASTER& p = particles[i];
+		p.position.X() = r.pos[0];
+		p.position.Y() = r.pos[1];
+		p.position.Z() = r.pos[2];
+		p.position.W() = r.pos[3];
+		p.radius = r.radius;
+		p.color = r.color;
+		particleTemplates[i] = r.alphaTemplate;
+	}
+
+	ok = ok && Fits(in, end, header.nCommands, sizeof(Command));
+	if (ok)
+		commands.resize(header.nCommands);
+	for (uint32 i = 0; ok && i < header.nCommands; ++i)
+	{
+		Command& c = commands[i];
+		ok = Get(in, c);
+		ok = ok && ((c.type == POLYGON && c.index < header.nPolygons)
+			|| (c.type == SKYBOX && c.index < header.nSkyboxes)
+			|| (c.type == PARTICLE && c.index < header.nParticles));
+	}
+
+	if (!ok)
+	{
+		std::cerr << "@RasterCapture::Read() -> Invalid file: " << file << std::endl;
+		Clear(0, 0);
+		return false;
+	}
+
+	Link();
+	return true;
+
+}	//End: RasterCapture::Read()
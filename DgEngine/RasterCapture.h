@@ -0,0 +1,123 @@
+/*!
+* @file RasterCapture.h
+*
+* Class header: RasterCapture
+*/
+
+#ifndef RASTERCAPTURE_H
+#define RASTERCAPTURE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "DgTypes.h"
+#include "Image.h"
+#include "Mipmap.h"
+#include "Materials.h"
+#include "ParticleAlphaTemplate.h"
+#include "Polygon_RASTER.h"
+#include "Polygon_RASTER_SB.h"
+#include "Particle_RASTER.h"
+
+class Rasterizer;
+
+/*!
+ * @ingroup graphics
+ *
+ * @class RasterCapture
+ *
+ * @brief Everything sent to a rasterizer for one frame, in draw order.
+ *
+ * A capture holds the polygons, skybox polygons and particles sent to a
+ * rasterizer, and copies of the materials, mipmaps, skybox images and
+ * particle alpha templates they point to. Each is stored once however
+ * many polygons use it. A capture can be saved to a binary file, loaded
+ * elsewhere and drawn again without the rest of the engine.
+ *
+ * Only the fields a rasterizer reads are kept: the flags and master alpha
+ * of materials, and the resident levels of mipmaps.
+ */
+class RasterCapture
+{
+public:
+
+	RasterCapture(): width(0), height(0) {}
+
+	//! Empty the capture, and set the size of the image drawn to.
+	void Clear(uint32 w, uint32 h);
+
+	//! Add the next item drawn.
+	void Add(const Polygon_RASTER&);
+	void Add(const Polygon_RASTER_SB&);
+	void Add(const Particle_RASTER&);
+
+	//! Draw everything, in order.
+	void Replay(Rasterizer&) const;
+
+	bool Write(const std::string& file) const;
+	bool Read(const std::string& file);
+
+	uint32 Width() const {return width;}
+	uint32 Height() const {return height;}
+
+	//! Triangles and particles drawn by Replay().
+	uint32 Triangles() const {return uint32(polygons.size() + skyboxes.size());}
+	uint32 Particles() const {return uint32(particles.size());}
+
+	//! Screen area covered by everything drawn, counting overdraw.
+	uint64 Pixels() const;
+
+private:
+
+	enum CommandType
+	{
+		POLYGON,
+		SKYBOX,
+		PARTICLE
+	};
+
+	struct Command
+	{
+		uint32 type;
+		uint32 index;
+	};
+
+	//Data members
+	uint32 width, height;
+
+	std::vector<Materials> materials;
+	std::vector<Mipmap> mipmaps;
+	std::vector<Image> images;
+	std::vector<ParticleAlphaTemplate> alphaTemplates;
+
+	std::vector<Polygon_RASTER> polygons;
+	std::vector<Polygon_RASTER_SB> skyboxes;
+	std::vector<Particle_RASTER> particles;
+	std::vector<Command> commands;
+
+	//Resource used by each item, -1 for none
+	std::vector<int32> polygonMaterials;
+	std::vector<int32> polygonMipmaps;
+	std::vector<int32> skyboxImages;
+	std::vector<int32> particleTemplates;
+
+	//Index of each resource by its address when captured
+	std::map<const void*, uint32> resourceIndex;
+
+	//--------------------------------------------------------------------------------
+	//		Functions
+	//--------------------------------------------------------------------------------
+	template<typename T>
+	int32 Store(const T* resource, std::vector<T>& dest);
+
+	//Point the items at the resources held. Until then, captured items
+	//point at the engine's resources.
+	void Link();
+
+private:
+	//DISALLOW Copy operations, items point into the capture
+	RasterCapture(const RasterCapture&);
+	RasterCapture& operator=(const RasterCapture&);
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*!
+* @file RasterReplay.cpp
+*
+* Raster stream replay
+*/
+
+#include "Utility.h"
+#include "Dg_io.h"
+#include "SettingsParser.h"
+#include "RasterCapture.h"
+#include "Rasterizer.h"
+#include "Image.h"
+#include "DgArray.h"
+#include "Profiler.h"
+#include "FrameWriter.h"
+#include <string>
+#include <vector>
+#include <iomanip>
+
+
+//--------------------------------------------------------------------------------
+//	@	RUN_RASTER_REPLAY()
+//--------------------------------------------------------------------------------
+//		Draw a raster capture repeatedly and time it
+//--------------------------------------------------------------------------------
+/*!
+ * Only the drawing is timed. The image and z-buffer are cleared between
+ * iterations.
+ */
+int RUN_RASTER_REPLAY(const SettingsParser& options)
+{
+    std::string file, str;
+    options.GetValue("raster_replay", file);
+
+    RasterCapture capture;
+    if (!capture.Read(file))
+    {
+        return 1;
+    }
+
+    uint32 w = capture.Width();
+    uint32 h = capture.Height();
+    if (w == 0 || h == 0)
+    {
+        std::cerr << "@RUN_RASTER_REPLAY() -> Capture has no output size: " << file << std::endl;
+        return 1;
+    }
+
+    uint32 iterations = 100;
+    if (options.GetValue("raster_replay_iterations", str))
+    {
+        StringToNumber(iterations, str, std::dec);
+    }
+    if (iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    //Output
+    std::vector<uint32_t> blank(size_t(w) * h, 0);
+    Image output;
+    output.Set(&blank[0], h, w);
+
+    DgArray<int32> zBuffer;
+    zBuffer.resize(w * h);
+
+    Rasterizer rasterizer;
+    rasterizer.SetOutput(output, zBuffer);
+
+    //Draw
+    int64 total = 0;
+    int64 fastest = -1;
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        output.Flush();
+        int32* zbuf = zBuffer.Data();
+        for (uint32 j = 0; j < zBuffer.max_size(); ++j)
+            zbuf[j] = 0;
+
+        int64 start = Profiler::Now();
+        capture.Replay(rasterizer);
+        int64 time = Profiler::Now() - start;
+
+        total += time;
+        if (fastest < 0 || time < fastest)
+            fastest = time;
+    }
+
+    //Save the last image drawn, to check kernel changes draw the same
+    if (options.GetValue("raster_replay_output", str))
+    {
+        FrameWriter::Format format = FrameWriter::PPM;
+        std::string formatStr;
+        if (options.GetValue("raster_replay_format", formatStr))
+        {
+            FrameWriter::ToFormat(formatStr, format);
+        }
+
+        FrameWriter writer;
+        if (!writer.Open(str, format) || !writer.Write(output))
+        {
+            return 1;
+        }
+    }
+
+    //Report
+    double seconds = double(total) / 1.0e9;
+    double triangles = double(capture.Triangles()) * iterations;
+    double particles = double(capture.Particles()) * iterations;
+    double pixels = double(capture.Pixels()) * iterations;
+
+    std::cout << std::fixed << std::setprecision(4)
+        << "{\n"
+        << "  \"file\": \"" << file << "\",\n"
+        << "  \"width\": " << w << ",\n"
+        << "  \"height\": " << h << ",\n"
+        << "  \"triangles\": " << capture.Triangles() << ",\n"
+        << "  \"particles\": " << capture.Particles() << ",\n"
+        << "  \"pixels\": " << capture.Pixels() << ",\n"
+        << "  \"iterations\": " << iterations << ",\n"
+        << "  \"mean_ms\": " << double(total) / 1.0e6 / iterations << ",\n"
+        << "  \"min_ms\": " << double(fastest) / 1.0e6 << ",\n"
+        << "  \"triangles_per_second\": " << (seconds > 0.0 ? triangles / seconds : 0.0) << ",\n"
+        << "  \"particles_per_second\": " << (seconds > 0.0 ? particles / seconds : 0.0) << ",\n"
+        << "  \"pixels_per_second\": " << (seconds > 0.0 ? pixels / seconds : 0.0) << "\n"
+        << "}" << std::endl;
+
+    return 0;
+
+}	//End: RUN_RASTER_REPLAY()
@@ -36,6 +36,7 @@
 #include <string>
 
 class Image;
+class DirtyRegion;
 struct Polygon_RASTER;
 struct Polygon_RASTER_SB;
 struct Particle_RASTER;
@@ -52,13 +53,18 @@ public:
 
 	//Constructor/Destructor
 	Rasterizer(): KEY(0), p0(NULL), p1(NULL), p2(NULL), 
-	materials(NULL), pixels(NULL), output_pixels(NULL), zBuffer(NULL){}
+	materials(NULL), pixels(NULL), output_pixels(NULL), zBuffer(NULL), dirty(NULL){}
 	~Rasterizer() {}
 
 	//Set output pixel array and z-buffer. Must be set before the
-	//rasterizer can be used.
-	void SetOutput(Image&, DgArray<int32>& zbuffer);
-	void NoOutput() { output_pixels = NULL; zBuffer = NULL; }
+	//rasterizer can be used. The area of everything drawn is added to
+	//the dirty region, if one is given.
+	void SetOutput(Image&, DgArray<int32>& zbuffer, DirtyRegion* = NULL);
+	void NoOutput() { output_pixels = NULL; zBuffer = NULL; dirty = NULL; }
+
+	//Size of the output image
+	uint32 OutputWidth() const { return output_pixels ? uint32(output_W) : 0; }
+	uint32 OutputHeight() const { return output_pixels ? uint32(output_H) : 0; }
 
 	//Render a polygon to the screen.
 	//void Draw(const Polygon&);
@@ -211,6 +217,9 @@ private:
 	//--------------------------------------------------------------------------------
 	int32* zBuffer;
 
+	//Areas drawn to
+	DirtyRegion* dirty;
+
 private:
 
 	//--------------------------------------------------------------------------------
@@ -220,6 +229,9 @@ private:
 	//Log an effect into the KEY
 	void AddSignature(uint8);
 
+	//Add the screen bounds of a triangle to the dirty region
+	void MarkDirty(const Vertex_RASTER&, const Vertex_RASTER&, const Vertex_RASTER&);
+
 	//--------------------------------------------------------------------------------
 	//		Drawing functions. After all effects have been setup and logged,
 	//		one of these functions will be chosen depending on the KEY.
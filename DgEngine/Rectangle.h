@@ -38,6 +38,8 @@ public:
 	void SetBox(const DgRect& b) { rect = b; }
 	void SetColor(uint32 c) { color = c; }
 
+	const DgRect& GetBox() const { return rect; }
+
 	void Draw(Image&) const;
 
 private:
@@ -0,0 +1,233 @@
+/*!
+* @file ResourceLoader.cpp
+*
+* Class definitions: ResourceLoader
+*/
+
+#include "ResourceLoader.h"
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::ResourceLoader()
+//--------------------------------------------------------------------------------
+//		Constructor
+//--------------------------------------------------------------------------------
+ResourceLoader::ResourceLoader(uint32 nThreads): outstanding(0), nextTicket(0), stop(false)
+{
+	if (nThreads == 0)
+	{
+		uint32 cores = std::thread::hardware_concurrency();
+		nThreads = (cores > 1) ? cores - 1 : 1;
+	}
+
+	for (uint32 i = 0; i < nThreads; ++i)
+		workers.push_back(std::thread(&ResourceLoader::Run, this));
+
+}	//End: ResourceLoader::ResourceLoader()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::~ResourceLoader()
+//--------------------------------------------------------------------------------
+//		Destructor
+//--------------------------------------------------------------------------------
+ResourceLoader::~ResourceLoader()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	workReady.notify_all();
+
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+
+}	//End: ResourceLoader::~ResourceLoader()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Submit()
+//--------------------------------------------------------------------------------
+//		Queue a job
+//--------------------------------------------------------------------------------
+ResourceLoader::Ticket ResourceLoader::Submit(const Function& work, const Function& done)
+{
+	Job job;
+	job.work = work;
+	job.done = done;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job.ticket = nextTicket++;
+		queued.push_back(job);
+		++outstanding;
+	}
+	workReady.notify_one();
+
+	return job.ticket;
+
+}	//End: ResourceLoader::Submit()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Update()
+//--------------------------------------------------------------------------------
+//		Hand over finished jobs
+//--------------------------------------------------------------------------------
+void ResourceLoader::Update()
+{
+	std::deque<Job> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		ready.swap(finished);
+		outstanding -= uint32(ready.size());
+	}
+
+	//Done functions may submit more jobs, so run them unlocked
+	for (size_t i = 0; i < ready.size(); ++i)
+	{
+		if (ready[i].done)
+			ready[i].done();
+	}
+
+}	//End: ResourceLoader::Update()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Wait()
+//--------------------------------------------------------------------------------
+//		Finish all jobs
+//--------------------------------------------------------------------------------
+void ResourceLoader::Wait()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (outstanding > finished.size())
+				workDone.wait(lock);
+
+			if (outstanding == 0)
+				return;
+		}
+
+		Update();
+	}
+
+}	//End: ResourceLoader::Wait()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Wait()
+//--------------------------------------------------------------------------------
+//		Finish one job. A queued job is taken from the queue and run here,
+//		rather than waiting for every job ahead of it.
+//--------------------------------------------------------------------------------
+void ResourceLoader::Wait(Ticket ticket)
+{
+	Job job;
+	bool queuedJob = false;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		for (std::deque<Job>::iterator it = queued.begin(); it != queued.end(); ++it)
+		{
+			if (it->ticket == ticket)
+			{
+				job = *it;
+				queued.erase(it);
+				queuedJob = true;
+				break;
+			}
+		}
+
+		//Being worked on, wait for it to finish
+		while (!queuedJob)
+		{
+			std::deque<Job>::iterator it = finished.begin();
+			while (it != finished.end() && it->ticket != ticket)
+				++it;
+
+			if (it != finished.end())
+			{
+				job = *it;
+				finished.erase(it);
+				--outstanding;
+				break;
+			}
+
+			//Already handed over
+			if (std::find(running.begin(), running.end(), ticket) == running.end())
+				return;
+
+			workDone.wait(lock);
+		}
+	}
+
+	if (queuedJob)
+	{
+		if (job.work)
+			job.work();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		--outstanding;
+	}
+
+	if (job.done)
+		job.done();
+
+}	//End: ResourceLoader::Wait()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Outstanding()
+//--------------------------------------------------------------------------------
+//		Jobs not yet handed over
+//--------------------------------------------------------------------------------
+uint32 ResourceLoader::Outstanding() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return outstanding;
+
+}	//End: ResourceLoader::Outstanding()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceLoader::Run()
+//--------------------------------------------------------------------------------
+//		Worker thread
+//--------------------------------------------------------------------------------
+void ResourceLoader::Run()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stop && queued.empty())
+				workReady.wait(lock);
+
+			if (stop)
+				return;
+
+			job = queued.front();
+			queued.pop_front();
+			running.push_back(job.ticket);
+		}
+
+		if (job.work)
+			job.work();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running.erase(std::find(running.begin(), running.end(), job.ticket));
+			job.work = Function();
+			finished.push_back(job);
+		}
+		workDone.notify_all();
+	}
+
+}	//End: ResourceLoader::Run()
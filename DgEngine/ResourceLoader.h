@@ -0,0 +1,102 @@
+/*!
+* @file ResourceLoader.h
+*
+* Class header: ResourceLoader
+*/
+
+#ifndef RESOURCELOADER_H
+#define RESOURCELOADER_H
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "DgTypes.h"
+
+/*!
+ * @ingroup utility_system
+ *
+ * @class ResourceLoader
+ *
+ * @brief Loads resources on worker threads.
+ *
+ * A job is a pair of functions. The work function runs on a worker thread
+ * and must not touch anything the main thread uses. The done function runs 
+ * on the main thread, in Update() or Wait(), and is where the loaded 
+ * resource is handed over to its manager.
+ *
+ * Submit() returns a ticket, which can be waited on to finish that job
+ * alone. A job still queued is then run on the calling thread.
+ */
+class ResourceLoader
+{
+public:
+	typedef std::function<void()> Function;
+	typedef uint64 Ticket;
+
+public:
+	//! Start the worker threads. Uses one less than the number of cores if 0.
+	explicit ResourceLoader(uint32 nThreads = 0);
+
+	//! Finishes all jobs, then stops the worker threads.
+	~ResourceLoader();
+
+	//! Queue a job.
+	Ticket Submit(const Function& work, const Function& done);
+
+	//! Run the done functions of finished jobs. Call once a frame.
+	void Update();
+
+	//! Block until all jobs have finished, then Update().
+	void Wait();
+
+	//! Finish one job and run its done function, leaving the others. 
+	//! Returns at once if the job has already been handed over.
+	void Wait(Ticket);
+
+	//! Number of jobs submitted which have not been handed over.
+	uint32 Outstanding() const;
+
+private:
+	struct Job
+	{
+		Ticket ticket;
+		Function work;
+		Function done;
+	};
+
+	void Run();
+
+private:
+	//Data members
+	std::vector<std::thread> workers;
+	std::deque<Job> queued;
+	std::deque<Job> finished;
+	std::vector<Ticket> running;	//Jobs being worked on
+	uint32 outstanding;			//Jobs queued or being worked on
+	Ticket nextTicket;
+	bool stop;
+
+	mutable std::mutex mutex;
+	std::condition_variable workReady;
+	std::condition_variable workDone;
+
+private:
+	//DISALLOW Copy operations
+	ResourceLoader(const ResourceLoader&);
+	ResourceLoader& operator=(const ResourceLoader&);
+
+};
+
+
+//--------------------------------------------------------------------------------
+//		Globals
+//--------------------------------------------------------------------------------
+namespace global
+{
+	extern ResourceLoader* LOADER;
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*!
+* @file ResourceRegistry.h
+*
+* Class header: ResourceRegistry<T>
+*/
+
+#ifndef RESOURCEREGISTRY_H
+#define RESOURCEREGISTRY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "DgTypes.h"
+
+
+/*!
+ * @ingroup utility_container
+ *
+ * @class ResourceRegistry
+ *
+ * @brief Owns named resources and hands out integer handles to them.
+ *
+ * Names are interned once, usually at load time, into a handle which
+ * indexes straight into the registry. Code which runs every frame should
+ * keep the handle and resolve it with Get(), which is O(1), instead of
+ * looking the name up again.
+ *
+ * A handle stays valid for the life of the registry, even after its
+ * resource is released. A released resource can be set again under the
+ * same handle. Resources are held by pointer, so a pointer returned by
+ * Get() stays valid until that resource is released.
+ */
+template<class T>
+class ResourceRegistry
+{
+public:
+
+	typedef uint32 Handle;
+
+	//! Returned by Find() if a name is not registered.
+	static const Handle INVALID = 0xFFFFFFFF;
+
+	ResourceRegistry() {}
+	~ResourceRegistry() {ReleaseAll();}
+
+	/*!
+	* @brief Get the handle of a name, registering the name if it is new.
+	*/
+	Handle Intern(const std::string&);
+
+	//! Handle of a registered name, INVALID if not registered.
+	Handle Find(const std::string&) const;
+
+	//! Name a handle was interned from.
+	const std::string& Name(Handle h) const {return names[h];}
+
+	//! Resource of a handle, NULL if not loaded.
+	T* Get(Handle h) const {return (h < items.size()) ? items[h] : NULL;}
+
+	/*!
+	* @brief Hand a resource to the registry. Any resource already held
+	* under the handle is deleted.
+	*
+	* @return The resource.
+	*/
+	T* Set(Handle, T*);
+
+	//! Delete the resource of a handle. The handle stays valid.
+	void Release(Handle);
+
+	//! Delete all resources. Handles stay valid.
+	void ReleaseAll();
+
+	//! Number of names registered.
+	uint32 Size() const {return uint32(names.size());}
+
+private:
+	//Data members
+	std::unordered_map<std::string, Handle> handles;
+	std::vector<std::string> names;
+	std::vector<T*> items;
+
+private:
+	//DISALLOW Copy operations
+	ResourceRegistry(const ResourceRegistry&);
+	ResourceRegistry& operator=(const ResourceRegistry&);
+
+};
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceRegistry<T>::Intern()
+//--------------------------------------------------------------------------------
+//		Get or make the handle of a name
+//--------------------------------------------------------------------------------
+template<class T>
+typename ResourceRegistry<T>::Handle ResourceRegistry<T>::Intern(const std::string& name)
+{
+	typename std::unordered_map<std::string, Handle>::const_iterator it = handles.find(name);
+	if (it != handles.end())
+		return it->second;
+
+	Handle h = Handle(names.size());
+	handles[name] = h;
+	names.push_back(name);
+	items.push_back(NULL);
+
+	return h;
+
+}	//End: ResourceRegistry<T>::Intern()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceRegistry<T>::Find()
+//--------------------------------------------------------------------------------
+//		Get the handle of a name
+//--------------------------------------------------------------------------------
+template<class T>
+typename ResourceRegistry<T>::Handle ResourceRegistry<T>::Find(const std::string& name) const
+{
+	typename std::unordered_map<std::string, Handle>::const_iterator it = handles.find(name);
+	return (it != handles.end()) ? it->second : INVALID;
+
+}	//End: ResourceRegistry<T>::Find()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceRegistry<T>::Set()
+//--------------------------------------------------------------------------------
+//		Take ownership of a resource
+//--------------------------------------------------------------------------------
+template<class T>
+T* ResourceRegistry<T>::Set(Handle h, T* t)
+{
+	if (items[h] != t)
+		delete items[h];
+
+	items[h] = t;
+	return t;
+
+}	//End: ResourceRegistry<T>::Set()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceRegistry<T>::Release()
+//--------------------------------------------------------------------------------
+//		Delete a resource
+//--------------------------------------------------------------------------------
+template<class T>
+void ResourceRegistry<T>::Release(Handle h)
+{
+	if (h >= items.size())
+		return;
+
+	delete items[h];
+	items[h] = NULL;
+
+}	//End: ResourceRegistry<T>::Release()
+
+
+//--------------------------------------------------------------------------------
+//	@	ResourceRegistry<T>::ReleaseAll()
+//--------------------------------------------------------------------------------
+//		Delete all resources
+//--------------------------------------------------------------------------------
+template<class T>
+void ResourceRegistry<T>::ReleaseAll()
+{
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		delete items[i];
+		items[i] = NULL;
+	}
+
+}	//End: ResourceRegistry<T>::ReleaseAll()
+
+#endif
@@ -28,8 +28,13 @@
 const std::string ERRORFILE = "errorlog.txt";
 const std::string impl::ttf::folder = "fonts/";
 const std::string ImageManager::s_schemaPath = "textures.xsd";
+const std::string ImageManager::s_manifestPath = "Images.xml";
+const std::string ImageManifest::cache_extension = "idx";
+const std::string Mipmap::cooked_extension = "mip";
 const std::string Mesh_List::folder = "objects/base_files/";
 const std::string Mesh_List::file_extension = "obj";
+const std::string Mesh_List::cooked_extension = "mesh";
+const std::string Mesh_List::lod_suffix = "#lod";
 const std::string Skybox::obj_file = "skybox";
 const std::string ViewportHandler::viewport_file = "Viewports.xml";
 const std::string MessageBox::messageBoxFile = "MessageBoxes.xml";
\ No newline at end of file
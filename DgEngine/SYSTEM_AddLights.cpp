@@ -2,15 +2,69 @@
 #include "GameDatabase.h"
 #include "DgTypes.h"
 #include "Light.h"
+#include "Profiler.h"
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------
+//		A light touching an aspect, ranked by how much it adds to the aspect.
+//--------------------------------------------------------------------------------
+struct LightCandidate
+{
+	entityID id;
+	bool isSpot;
+	float importance;	//intensity / distance^2
+	Tuple<float> color;
+
+	//Sorts most important first
+	bool operator< (const LightCandidate& other) const
+	{return importance > other.importance;}
+};
+
+static DgArray<LightCandidate> candidates;
+static DgArray<SpatialGrid::Item> nearby;
+
+
+//--------------------------------------------------------------------------------
+//	@	AddCandidate()
+//--------------------------------------------------------------------------------
+//		Rate a light against an aspect sphere
+//--------------------------------------------------------------------------------
+static void AddCandidate(entityID id, bool isSpot, const Light& light,
+						 const Point4& source, const Sphere& sphere)
+{
+	//Distance from the light to the aspect center. Avoid the singularity
+	//when the light is inside the aspect.
+	float d2 = DgMax((sphere.Center() - source).LengthSquared(), sphere.SqRadius());
+	d2 = DgMax(d2, EPSILON);
+
+	LightCandidate c;
+	c.id = id;
+	c.isSpot = isSpot;
+	c.importance = light.Intensity() / d2;
+	c.color = light.Color();
+
+	candidates.push_back(c);
+
+}	//End: AddCandidate()
+
 
 //--------------------------------------------------------------------------------
 /*
-		Tests all lights in the input array against the entity.
+		Finds the lights touching each aspect through the spatial index.
 		Maybe restrict testing to only those entities in the frustum.
-*/ 
+
+		If more lights than data.lightBudget touch an aspect, only the most
+		important are attached. The rest are reduced to a constant color
+		in Component_LIGHTS_AFFECTING::residual. This is the light each
+		would add at the aspect center, scaled by 1/4, the mean Lambert term
+		over all normal directions.
+*/
 //--------------------------------------------------------------------------------
 void SYSTEM_AddLights(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::ADD_LIGHTS);
+
 	int ai = 0;
 	for (int li = 0; li < data.LightsAffecting.size(); ++li)
 	{
@@ -18,27 +72,68 @@ void SYSTEM_AddLights(GameDatabase& data)
 		Component_LIGHTS_AFFECTING& lightsAffecting = data.LightsAffecting[li];
 		lightsAffecting.pointlights.clear();
 		lightsAffecting.spotlights.clear();
+		lightsAffecting.residual.Set(0.0f);
 
 		//find BV
 		if (!data.Aspects.find(data.LightsAffecting.ID(li), ai, ai))
 			continue;
 
 		Component_ASPECT& aspect = data.Aspects[ai];
+		candidates.clear();
+
+		//Lights whose bounds touch the aspect
+		nearby.clear();
+		data.spatialGrid.Query(aspect.sphere.current,
+			SpatialGrid::POINTLIGHT | SpatialGrid::SPOTLIGHT, nearby);
 
-		//For all pointlights in the database
-		for (int pi = 0; pi < data.PointLights.size(); ++pi)
+		for (uint32 i = 0; i < nearby.size(); ++i)
 		{
-			if (data.PointLights[pi].light.current.Test(aspect.sphere.current) == 1)
-				lightsAffecting.pointlights.insert(data.PointLights.ID(pi));
+			int index = 0;
+			if (nearby[i].type == SpatialGrid::POINTLIGHT)
+			{
+				if (!data.PointLights.find(nearby[i].id, index))
+					continue;
+
+				//Bounds are the light sphere, no further test needed
+				const PointLight& light = data.PointLights[index].light.current;
+				AddCandidate(nearby[i].id, false, light,
+					light.Position(), aspect.sphere.current);
+			}
+			else
+			{
+				if (!data.SpotLights.find(nearby[i].id, index))
+					continue;
+
+				const SpotLight& light = data.SpotLights[index].light.current;
+				if (light.Test(aspect.sphere.current) == 1)
+					AddCandidate(nearby[i].id, true, light,
+						light.GetCone().Origin(), aspect.sphere.current);
+			}
+		}
+
+		//Keep the most important lights
+		uint32 nKeep = candidates.size();
+		if (data.lightBudget > 0 && nKeep > data.lightBudget)
+		{
+			nKeep = data.lightBudget;
+			std::nth_element(candidates.Data(),
+				candidates.Data() + nKeep,
+				candidates.Data() + candidates.size());
 		}
 
-		//For all spotlights in the database
-		for (int si = 0; si < data.SpotLights.size(); ++si)
+		for (uint32 i = 0; i < nKeep; ++i)
 		{
-			if (data.SpotLights[si].light.current.Test(aspect.sphere.current) == 1)
-				lightsAffecting.spotlights.insert(data.SpotLights.ID(si));
+			if (candidates[i].isSpot)
+				lightsAffecting.spotlights.insert(candidates[i].id);
+			else
+				lightsAffecting.pointlights.insert(candidates[i].id);
 		}
 
+		//Fold the rest into a constant term
+		for (uint32 i = nKeep; i < candidates.size(); ++i)
+		{
+			lightsAffecting.residual += candidates[i].color * (0.25f * candidates[i].importance);
+		}
 	}
 
-}	//End: SYSTEM_Move()
\ No newline at end of file
+}	//End: SYSTEM_AddLights()
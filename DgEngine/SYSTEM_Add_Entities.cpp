@@ -3,11 +3,15 @@
 #include "Clipper.h"
 #include "Mesh.h"
 #include "Texture.h"
+#include "ImageManager.h"
 #include "Matrix44.h"
 #include "Viewport.h"
+#include "Profiler.h"
 
 #include "Debugger.h"
 
+#include <string.h>
+
 
 //--------------------------------------------------------------------------------
 //	@	ResetData(GameDatabase& data)
@@ -21,9 +25,160 @@ static void ResetData(GameDatabase& data)
 		//Clear lights list
 		data.LightsAffecting[li].pointlights.clear();
 		data.LightsAffecting[li].spotlights.clear();
+		data.LightsAffecting[li].residual.Set(0.0f);
 	}
 }	//End: ResetData(GameDatabase& data)
 
+
+//--------------------------------------------------------------------------------
+//		Scratch space for building light cache keys
+//--------------------------------------------------------------------------------
+static DgArray<uint32> lightKey;
+
+
+//--------------------------------------------------------------------------------
+//	@	FloatBits()
+//--------------------------------------------------------------------------------
+//		Bit pattern of a float
+//--------------------------------------------------------------------------------
+static uint32 FloatBits(float f)
+{
+	uint32 result;
+	memcpy(&result, &f, sizeof(uint32));
+	return result;
+
+}	//End: FloatBits()
+
+
+//--------------------------------------------------------------------------------
+//	@	BuildLightKey()
+//--------------------------------------------------------------------------------
+//		The key is the residual light, then the ID and stamp of each light 
+//		affecting the aspect. Point lights and spot lights are separated 
+//		by ENTITYID::ROOT.
+//--------------------------------------------------------------------------------
+static void BuildLightKey(GameDatabase& data, const Component_LIGHTS_AFFECTING* lights)
+{
+	lightKey.clear();
+
+	if (lights == NULL)
+		return;
+
+	lightKey.push_back(FloatBits(lights->residual[0]));
+	lightKey.push_back(FloatBits(lights->residual[1]));
+	lightKey.push_back(FloatBits(lights->residual[2]));
+
+	int pli = 0;
+	for (int32 i = 0; i < lights->pointlights.size(); ++i)
+	{
+		if (!data.PointLights.find(lights->pointlights[i], pli, pli))
+			continue;
+
+		lightKey.push_back(lights->pointlights[i]);
+		lightKey.push_back(data.PointLights[pli].stamp);
+	}
+
+	lightKey.push_back(ENTITYID::ROOT);
+
+	int sli = 0;
+	for (int32 i = 0; i < lights->spotlights.size(); ++i)
+	{
+		if (!data.SpotLights.find(lights->spotlights[i], sli, sli))
+			continue;
+
+		lightKey.push_back(lights->spotlights[i]);
+		lightKey.push_back(data.SpotLights[sli].stamp);
+	}
+
+}	//End: BuildLightKey()
+
+
+//--------------------------------------------------------------------------------
+//	@	LightAspect()
+//--------------------------------------------------------------------------------
+//		Sets the color of the active vertices in the mesh drawn for the
+//		aspect, which may be one of its lower detail levels. Colors are
+//		taken from the aspect light cache where possible, only vertices 
+//		without a cached color are lit.
+//--------------------------------------------------------------------------------
+static void LightAspect(GameDatabase& data, entityID asp_id, int& asp_li,
+	Component_ASPECT& aspect, Mesh& mesh, const VQS& T_WLD_OBJ, const VQS& T_OBJ_WLD)
+{
+	//Find the lights affecting this aspect
+	Component_LIGHTS_AFFECTING* affectinglights(NULL);
+	if (aspect.materials.IsReflective() &&
+		data.LightsAffecting.find(asp_id, asp_li, asp_li))
+	{
+		affectinglights = &data.LightsAffecting[asp_li];
+	}
+
+	//Drop cached colors if the aspect or its lights have changed
+	BuildLightKey(data, affectinglights);
+	aspect.lightCache.Validate(mesh, T_WLD_OBJ, lightKey);
+
+	//All active vertices have been lit before
+	if (aspect.lightCache.Fetch(mesh) == 0)
+	{
+		aspect.lightCache.Store(mesh);
+		return;
+	}
+
+	if (affectinglights != NULL)
+	{
+		//Add ambient light
+		data.ambientLight.AddToMesh(mesh, VQS(), aspect.materials);
+
+		//Add lights that did not fit in the light budget
+		if (affectinglights->residual.Max() > 0.0f)
+		{
+			DgArray<Vertex>& VList = mesh.GetVertices();
+			for (uint32 i = 0; i < VList.size(); ++i)
+			{
+				if (VList[i].state == 'x')
+					continue;
+
+				VList[i].clr += affectinglights->residual;
+			}
+		}
+
+		//Add directional lights
+		for (int32 i = 0; i < data.directionalLights.size(); ++i)
+		{
+			data.directionalLights[i].AddToMesh(mesh, T_OBJ_WLD, aspect.materials);
+		}
+
+		//Add points lights
+		int pli = 0;
+		for (int32 i = 0; i < affectinglights->pointlights.size(); ++i)
+		{
+			//Find light
+			if (!data.PointLights.find(affectinglights->pointlights[i], pli, pli))
+				continue;
+
+			data.PointLights[pli].light.current.AddToMesh(mesh, T_OBJ_WLD, aspect.materials);
+		}
+
+		//Add spot lights
+		int sli = 0;
+		for (int32 i = 0; i < affectinglights->spotlights.size(); ++i)
+		{
+			//Find light
+			if (!data.SpotLights.find(affectinglights->spotlights[i], sli, sli))
+				continue;
+
+			data.SpotLights[sli].light.current.AddToMesh(mesh, T_OBJ_WLD, aspect.materials);
+		}
+	}
+
+	//Adjust material lighting to each vertex in the object
+	aspect.materials.AdjustMesh(mesh);
+
+	//Save new colors
+	aspect.lightCache.Store(mesh);
+
+}	//End: LightAspect()
+
+
 /*!
  * Send all aspects through the pipeline
  *
@@ -37,18 +192,13 @@ static void AddAspects(GameDatabase& data, uint32 clock_time, Component_CAMERA&
 	Viewport* camera_view = camera.cameraSystem.GetViewport();
 
 	//--------------------------------------------------------------------------------
-	//		Loop through all aspects
+	//		Loop through all aspects inside the frustum
 	//--------------------------------------------------------------------------------
 	int asp_pi = 0;
 	int asp_li = 0;
-	for (int ai = 0; ai < data.Aspects.size(); ++ai)
+	for (uint32 vi = 0; vi < data.visibleAspects.size(); ++vi)
 	{
-		//--------------------------------------------------------------------------------
-		//		Check if object is outside frustum
-		//--------------------------------------------------------------------------------
-		if (data.Aspects[ai].intersects == Frustum::OUTSIDE)
-			continue;
-
+		const int ai = data.visibleAspects[vi];
 		const entityID asp_id = data.Aspects.ID(ai);
 
 		//--------------------------------------------------------------------------------
@@ -67,6 +217,14 @@ static void AddAspects(GameDatabase& data, uint32 clock_time, Component_CAMERA&
 		VQS vqs_temp(Inverse(aspect_position.T_WLD_OBJ));
 
 
+		//--------------------------------------------------------------------------------
+		//		Choose a level of detail from the size of the aspect on screen
+		//--------------------------------------------------------------------------------
+		float pixelRadius = camera.cameraSystem.ProjectedRadius(aspect.sphere.current);
+		aspect.lod = aspect.mesh->SelectLOD(pixelRadius, aspect.lod);
+		Mesh* mesh = aspect.mesh->GetLOD(aspect.lod);
+
+
 		//--------------------------------------------------------------------------------
 		//		Backcull polygons
 		//--------------------------------------------------------------------------------
@@ -74,80 +232,62 @@ static void AddAspects(GameDatabase& data, uint32 clock_time, Component_CAMERA&
 		//Only backcull if not colorkeyed
 		if (!aspect.materials.IsDoubleSided())
 		{
+			ProfileScope profile(Profiler::CULL);
+
 			//Transform camera position to Object BASE cordinates
 			Point4 camera_origin_obj(vqs_temp * camera_origin);
 
-			//Backcull
-			aspect.mesh->BackCull(camera_origin_obj);
+			//Backcull. Clusters of polygons are also tested against the
+			//frustum planes the aspect straddles.
+			mesh->BackCull(camera_origin_obj, 
+				camera.cameraSystem.GetFrustum(),
+				aspect_position.T_WLD_OBJ,
+				aspect.intersects);
 		}
 		else
 		{
 			//Activate all vertices
-			aspect.mesh->ActivateAll();
+			mesh->ActivateAll();
 		}
 
 
+
 		//--------------------------------------------------------------------------------
-		//		Lighting calculations
+		//		Transform object to camera space
 		//--------------------------------------------------------------------------------
 
-		if (aspect.materials.IsMasterOn())
-		{
-			if (aspect.materials.IsReflective() &&
-				data.LightsAffecting.find(asp_id, asp_li, asp_li))
-			{
-				Component_LIGHTS_AFFECTING& affectinglights = data.LightsAffecting[asp_li];
-
-				//Add ambient light
-				data.ambientLight.AddToMesh(*aspect.mesh, VQS(), aspect.materials);
-
-				//Add directional lights
-				for (int32 i = 0; i < data.directionalLights.size(); ++i)
-				{
-					data.directionalLights[i].AddToMesh(*aspect.mesh, vqs_temp, aspect.materials);
-				}
-
-				//Add points lights
-				int pli = 0;
-				for (int32 i = 0; i < affectinglights.pointlights.size(); ++i)
-				{
-					//Find light
-					if (!data.PointLights.find(affectinglights.pointlights[i], pli, pli))
-						continue;
-
-					data.PointLights[pli].light.current.AddToMesh(*aspect.mesh, vqs_temp, aspect.materials);
-				}
-
-				//Add spot lights
-				int sli = 0;
-				for (int32 i = 0; i < affectinglights.spotlights.size(); ++i)
-				{
-					//Find light
-					if (!data.SpotLights.find(affectinglights.spotlights[i], sli, sli))
-						continue;
-
-					data.SpotLights[sli].light.current.AddToMesh(*aspect.mesh, vqs_temp, aspect.materials);
-				}
+		//Mesh to camera space transform
+		//T: camera_object  =  T:camera_world * T:world_object
+		VQS T_CAM_OBJ(camera.T_OBJ_WLD * aspect_position.T_WLD_OBJ);
+
+		//Transform active vertices in the object to camera space
+		mesh->TransformActiveVertices(T_CAM_OBJ);
 
-			}
 
-			//Adjust material lighting to each vertex in the object
-			aspect.materials.AdjustMesh(*(aspect.mesh));
 
+		//--------------------------------------------------------------------------------
+		//		Remove polygons that would be clipped away, so we only light
+		//		vertices that reach the master polygon list.
+		//--------------------------------------------------------------------------------
+
+		{
+			ProfileScope profile(Profiler::CULL);
+			camera_view->CullObject(mesh, aspect.intersects);
 		}
 
 
 
 		//--------------------------------------------------------------------------------
-		//		Transform object to camera space
+		//		Lighting calculations. Only vertices not lit in a previous
+		//		frame, or by a previous camera, are lit.
 		//--------------------------------------------------------------------------------
 
-		//Mesh to camera space transform
-		//T: camera_object  =  T:camera_world * T:world_object
-		vqs_temp = camera.T_OBJ_WLD * aspect_position.T_WLD_OBJ;
-
-		//Transform active vertices in the object to camera space
-		aspect.mesh->TransformActiveVertices(vqs_temp);
+		if (aspect.materials.IsMasterOn())
+		{
+			ProfileScope profile(Profiler::LIGHTING);
+			LightAspect(data, asp_id, asp_li, aspect, *mesh,
+				aspect_position.T_WLD_OBJ, vqs_temp);
+		}
 
 
 
@@ -157,12 +297,15 @@ static void AddAspects(GameDatabase& data, uint32 clock_time, Component_CAMERA&
 
 		const Mipmap *mm_temp(NULL);
 		if (aspect.texture != NULL)
-			mm_temp = aspect.texture->GetMipmap(clock_time);
+			mm_temp = &global::IMAGE_MANAGER->GetMipmap(aspect.texture->GetMipmap(clock_time));
 
-		camera_view->AddObject(aspect.mesh,
-			aspect.materials,
-			mm_temp,
-			aspect.intersects);
+		{
+			ProfileScope profile(Profiler::CLIP);
+			camera_view->AddObject(mesh,
+				aspect.materials,
+				mm_temp,
+				aspect.intersects);
+		}
 
 
 
@@ -171,7 +314,7 @@ static void AddAspects(GameDatabase& data, uint32 clock_time, Component_CAMERA&
 		//--------------------------------------------------------------------------------
 
 		//Reset base
-		aspect.mesh->ResetStates();
+		mesh->ResetStates();
 
 	}
 }
@@ -200,6 +343,8 @@ static void AddParticleEmitters(GameDatabase& data, Viewport* view, VQS& T_OBJ_W
 //--------------------------------------------------------------------------------
 void SYSTEM_Add_Entities(GameDatabase& data, uint32 clock_time)
 {
+	ProfileScope profile(Profiler::ADD_ENTITIES);
+
 	//Draw for each camera
 	int cam_pi = 0;
 	for (int ci = 0; ci < data.Cameras.size(); ++ci)
@@ -1,6 +1,7 @@
 #include "Systems.h"
 #include "GameDatabase.h"
 #include "Viewport.h"
+#include "Profiler.h"
 
 
 //--------------------------------------------------------------------------------
@@ -11,6 +12,8 @@ planes have been set in the clipper.
 //--------------------------------------------------------------------------------
 void SYSTEM_Add_Skyboxes(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::ADD_SKYBOXES);
+
 	//add current skybox to each camera
 	for (int cam_ind = 0; cam_ind < data.Cameras.size(); ++cam_ind)
 	{
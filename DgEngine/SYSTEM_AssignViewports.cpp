@@ -1,6 +1,7 @@
 #include "Systems.h"
 #include "GameDatabase.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------------------------------
 /*
@@ -11,6 +12,8 @@
 //--------------------------------------------------------------------------------
 void SYSTEM_AssignViewports(GameDatabase& data, DgArray<ViewportEvent>& events)
 {
+	ProfileScope profile(Profiler::ASSIGN_VIEWPORTS);
+
 	for (int i = events.size() - 1; i >= 0; --i)
 	{
 		ViewportEvent e = events[i];
@@ -2,6 +2,7 @@
 #include "GameDatabase.h"
 #include "ObjectController.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------------------------------
 /*
@@ -12,6 +13,8 @@
 void SYSTEM_CameraControl(GameDatabase& data, 
 						  const ObjectController& controller, float dt)
 {
+	ProfileScope profile(Profiler::CAMERA_CONTROL);
+
 	//Try to find camera
 	int index;
 	if (!data.Movements.find(data.player, index))
@@ -40,6 +43,8 @@ void SYSTEM_CameraControl(GameDatabase& data,
 //--------------------------------------------------------------------------------
 void SYSTEM_CameraPost(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::CAMERA_POST);
+
 	//Try to find components
 	int pos = 0;
 	for (int i = 0; i < data.Cameras.size(); ++i)
@@ -1,25 +1,31 @@
 #include "Systems.h"
 #include "GameDatabase.h"
+#include "Profiler.h"
+#include <algorithm>
 
 //--------------------------------------------------------------------------------
 /*
 		Test a Bounding Volume against a frustum.
+		* postcondition: data.visibleAspects holds the aspects touching 
+		  the frustum, with their intersects code set.
 */ 
 //--------------------------------------------------------------------------------
 void SYSTEM_FrustumCull(GameDatabase& data, entityID camera_id)
 {
+	ProfileScope profile(Profiler::CULL);
+
 	//Find camera
 	int ci;
 	if (!data.Cameras.find(camera_id, ci))
 		return;
 
-	//Test aspects
-	for (int  i = 0; i < data.Aspects.size(); ++i)
-	{
-		data.Aspects[i].intersects = TestFrustumSphere(
-			data.Cameras[ci].cameraSystem.GetFrustum(), 
-			data.Aspects[i].sphere.current);
-	}
+	//Test aspects. Keep the visible list in map order for the 
+	//component searches that follow.
+	data.visibleAspects.clear();
+	data.aspectTree.Cull(data.Cameras[ci].cameraSystem.GetFrustum(),
+		data.Aspects, data.visibleAspects);
+	std::sort(data.visibleAspects.Data(), 
+		data.visibleAspects.Data() + data.visibleAspects.size());
 
 	//Test particles
 	for (int i = 0; i < data.ParticleEmitters.size(); ++i)
@@ -2,6 +2,7 @@
 #include "VQS.h"
 #include "GameDatabase.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------------------------------
 /*
@@ -12,6 +13,8 @@
 //--------------------------------------------------------------------------------
 void SYSTEM_Move(GameDatabase& data, float dt)
 {
+	ProfileScope profile(Profiler::MOVE);
+
 	int index = 0;
 	for (int i = 0; i < data.Movements.size(); ++i)
 	{
@@ -5,6 +5,7 @@
 #include "Texture.h"
 #include "Matrix44.h"
 #include "Viewport.h"
+#include "Profiler.h"
 
 
 //--------------------------------------------------------------------------------
@@ -15,6 +16,8 @@ planes have been set in the clipper.
 //--------------------------------------------------------------------------------
 void SYSTEM_Render(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::RENDER);
+
 	//Draw for each camera
 	int cam_pi = 0;
 	for (int ci = 0; ci < data.Cameras.size(); ++ci)
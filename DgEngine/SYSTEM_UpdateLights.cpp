@@ -1,15 +1,19 @@
 #include "Systems.h"
 #include "GameDatabase.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------------------------------
 /*
 		* Moves an entity's lights
-        * postcondition: Transforms lights to new vqs
+        * postcondition: Transforms lights to new vqs, bumps the stamp of
+		  any light that changed, updates light bounds in the spatial index.
 */ 
 //--------------------------------------------------------------------------------
 void SYSTEM_UpdateLights(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::UPDATE_LIGHTS);
+
 	int index = 0;
 	for (int i = 0; i < data.PointLights.size(); ++i)
 	{
@@ -17,8 +21,17 @@ void SYSTEM_UpdateLights(GameDatabase& data)
 		if (data.Positions.find(data.PointLights.ID(i), index, index))
 		{
 			//Transform the lights
+			PointLight previous(data.PointLights[i].light.current);
 			data.PointLights[i].light.TransformQuick(data.Positions[index].T_WLD_OBJ);
+
+			//Flag a change
+			if (data.PointLights[i].light.current != previous)
+				++data.PointLights[i].stamp;
 		}
+
+		//Move in the spatial index
+		data.spatialGrid.Update(data.PointLights.ID(i), SpatialGrid::POINTLIGHT,
+			data.PointLights[i].light.current.GetSphere());
 	}
 
 	index = 0;
@@ -28,7 +41,18 @@ void SYSTEM_UpdateLights(GameDatabase& data)
 		if (data.Positions.find(data.SpotLights.ID(i), index, index))
 		{
 			//Transform the lights
+			SpotLight previous(data.SpotLights[i].light.current);
 			data.SpotLights[i].light.TransformQuick(data.Positions[index].T_WLD_OBJ);
+
+			//Flag a change
+			if (data.SpotLights[i].light.current != previous)
+				++data.SpotLights[i].stamp;
 		}
+
+		//Move in the spatial index. The cone lies inside the sphere
+		//at its origin with the same radius.
+		const Cone& cone = data.SpotLights[i].light.current.GetCone();
+		data.spatialGrid.Update(data.SpotLights.ID(i), SpatialGrid::SPOTLIGHT,
+			Sphere(cone.Origin(), cone.Radius()));
 	}
 }	//End: SYSTEM_Move()
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "GameDatabase.h"
 #include "Dg_io.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 
 /*!
@@ -13,6 +14,8 @@
  */
 void SYSTEM_UpdateParticleEmitters(GameDatabase& data, float dt)
 {
+	ProfileScope profile(Profiler::PARTICLE_EMITTERS);
+
 	//add current skybox to each camera
 	int index = 0;
     int mov_ind = 0;
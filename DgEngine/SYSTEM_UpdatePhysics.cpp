@@ -2,15 +2,19 @@
 #include "VQS.h"
 #include "GameDatabase.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 //--------------------------------------------------------------------------------
 /*
 		* Updates BV
-        * postcondition: Generates new BV->current
+        * postcondition: Generates new BV->current, aspect spheres
+		  updated in the aspect tree.
 */ 
 //--------------------------------------------------------------------------------
 void SYSTEM_UpdatePhysics(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::PHYSICS);
+
 	//Update Physics bounding volumes
 	int index = 0;
 	for (int i = 0; i < data.Physics.size(); ++i)
@@ -44,4 +48,7 @@ void SYSTEM_UpdatePhysics(GameDatabase& data)
 		aspect.box.TransformQuick(cur_pos.T_WLD_OBJ);
 		aspect.sphere.TransformQuick(cur_pos.T_WLD_OBJ);
 	}
+
+	//Fit the culling hierarchy to the new aspect spheres
+	data.aspectTree.Update(data.Aspects);
 }
\ No newline at end of file
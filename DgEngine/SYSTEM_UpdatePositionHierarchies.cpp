@@ -3,6 +3,7 @@
 #include "GameDatabase.h"
 #include "Dg_io.h"
 #include "DgTypes.h"
+#include "Profiler.h"
 
 static void Update(Component_POSITION& pos, DgMap<entityID, Component_POSITION>& data)
 {
@@ -31,6 +32,8 @@ static void Update(Component_POSITION& pos, DgMap<entityID, Component_POSITION>&
 //--------------------------------------------------------------------------------
 void SYSTEM_UpdatePositionHierarchies(GameDatabase& data)
 {
+	ProfileScope profile(Profiler::POSITION_HIERARCHIES);
+
 	for (int i = 0; i < data.Positions.size(); ++i)
 	{
 		//Extract current position object reference
@@ -43,6 +43,10 @@ bool SettingsParser::Load(const std::string& file)
         file_in >> tag;
         std::getline(file_in, str);
 
+        //Drop the whitespace between the tag and the value
+        str.erase(0, str.find_first_not_of(" \t"));
+        str.erase(str.find_last_not_of(" \t\r") + 1);
+
         m_values.insert(std::pair<std::string, std::string>(tag, str));
     }
 
@@ -62,4 +66,30 @@ bool SettingsParser::GetValue(const std::string& tag, std::string& out) const
 
     out = it->second;
     return true;
-}
\ No newline at end of file
+}
+
+
+void SettingsParser::SetValue(const std::string& tag, const std::string& value)
+{
+    m_values[tag] = value;
+}
+
+
+void SettingsParser::ParseArgs(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg.compare(0, 2, "--") != 0)
+        {
+            std::cerr << "@SettingsParser::ParseArgs() -> Ignoring argument: " << arg << std::endl;
+            continue;
+        }
+
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos)
+            SetValue(arg.substr(2), "1");
+        else
+            SetValue(arg.substr(2, eq - 2), arg.substr(eq + 1));
+    }
+}
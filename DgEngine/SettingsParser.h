@@ -11,6 +11,13 @@ public:
     bool Load(const std::string& file);
     bool GetValue(const std::string& tag, std::string& out) const;
 
+    //Add a value, replacing any loaded from file
+    void SetValue(const std::string& tag, const std::string& value);
+
+    //Set values from command line arguments of the form --tag=value. 
+    //--tag on its own sets the value to 1.
+    void ParseArgs(int argc, char* argv[]);
+
 private:
     std::map<std::string, std::string> m_values;
 
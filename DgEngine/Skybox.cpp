@@ -17,6 +17,17 @@
 #include "Dg_io.h"
 #include <vector>
 
+//--------------------------------------------------------------------------------
+//		The cube mesh. Its name is interned once, then found by handle.
+//--------------------------------------------------------------------------------
+static Mesh* CubeMesh()
+{
+	static Mesh_List::Handle handle = global::MESH_MANAGER->GetHandle(Skybox::obj_file);
+	return (*global::MESH_MANAGER)[handle];
+
+}	//End: CubeMesh()
+
+
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
@@ -24,7 +35,7 @@ Skybox::Skybox(): top(NULL), bottom(NULL), left(NULL),
 	right(NULL), front(NULL), back(NULL)
 {
 	//Load geometry
-	cube = MESH_MANAGER[obj_file];
+	cube = CubeMesh();
 
 }	//End: Skybox::Skybox()
 
@@ -54,7 +65,7 @@ void Skybox::init(const Skybox& other)
 //--------------------------------------------------------------------------------
 //		Copy constructor
 //--------------------------------------------------------------------------------
-Skybox::Skybox(const Skybox& other) : cube(MESH_MANAGER[obj_file])
+Skybox::Skybox(const Skybox& other) : cube(other.cube)
 {
 	init(other);
 
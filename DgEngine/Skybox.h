@@ -34,6 +34,9 @@ public:
 	//Send skybox to master polygon list
 	void SendToRenderer(Viewport*) const;
 
+	//Tag of the cube mesh
+	const static std::string obj_file;
+
 private:
 	//--------------------------------------------------------------------------------
 	//		Data
@@ -53,11 +56,6 @@ private:
 	//Orientation of the Skybox
 	Quaternion Q_WLD_OBJ;
 
-	//--------------------------------------------------------------------------------
-	//		Statics
-	//--------------------------------------------------------------------------------
-	const static std::string obj_file;
-
 	//--------------------------------------------------------------------------------
 	//		Functions
 	//--------------------------------------------------------------------------------
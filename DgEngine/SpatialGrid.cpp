@@ -0,0 +1,427 @@
+/*!
+* @file SpatialGrid.cpp
+*
+* Class definitions: SpatialGrid
+*/
+
+#include "SpatialGrid.h"
+#include "CommonMath.h"
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::SpatialGrid()
+//--------------------------------------------------------------------------------
+//		Constructor
+//--------------------------------------------------------------------------------
+SpatialGrid::SpatialGrid(): cellSize(16.0f), invCellSize(1.0f / 16.0f),
+	queryStamp(0)
+{
+}	//End: SpatialGrid::SpatialGrid()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::init()
+//--------------------------------------------------------------------------------
+//		Initialise grid from another
+//--------------------------------------------------------------------------------
+void SpatialGrid::init(const SpatialGrid& other)
+{
+	cellSize = other.cellSize;
+	invCellSize = other.invCellSize;
+	entries = other.entries;
+	freeEntries = other.freeEntries;
+	lookup = other.lookup;
+	large = other.large;
+	queryStamp = other.queryStamp;
+
+	for (uint32 i = 0; i < NUMBUCKETS; ++i)
+		buckets[i] = other.buckets[i];
+
+}	//End: SpatialGrid::init()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::SpatialGrid()
+//--------------------------------------------------------------------------------
+//		Copy constructor
+//--------------------------------------------------------------------------------
+SpatialGrid::SpatialGrid(const SpatialGrid& other)
+{
+	init(other);
+
+}	//End: SpatialGrid::SpatialGrid()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::operator=()
+//--------------------------------------------------------------------------------
+//		Assignment
+//--------------------------------------------------------------------------------
+SpatialGrid& SpatialGrid::operator=(const SpatialGrid& other)
+{
+	if (this == &other)
+		return *this;
+
+	init(other);
+
+	return *this;
+
+}	//End: SpatialGrid::operator=()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Hash()
+//--------------------------------------------------------------------------------
+//		Cell coordinates to bucket
+//--------------------------------------------------------------------------------
+uint32 SpatialGrid::Hash(int32 x, int32 y, int32 z)
+{
+	uint32 h = (uint32(x) * 73856093u) ^ (uint32(y) * 19349663u) ^ (uint32(z) * 83492791u);
+	return h & (NUMBUCKETS - 1);
+
+}	//End: SpatialGrid::Hash()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::RemoveFrom()
+//--------------------------------------------------------------------------------
+//		Remove one occurrence of a value from an unordered list
+//--------------------------------------------------------------------------------
+void SpatialGrid::RemoveFrom(DgArray<uint32>& list, uint32 val)
+{
+	for (uint32 i = 0; i < list.size(); ++i)
+	{
+		if (list[i] == val)
+		{
+			list[i] = list[list.size() - 1];
+			list.pop_back();
+			return;
+		}
+	}
+
+}	//End: SpatialGrid::RemoveFrom()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::GetCellRange()
+//--------------------------------------------------------------------------------
+//		Cells overlapped by the bounding box of a sphere
+//--------------------------------------------------------------------------------
+void SpatialGrid::GetCellRange(const Sphere& s, int32 lower[3], int32 upper[3]) const
+{
+	//Keep well inside the range of int32
+	const float limit = 1.0e9f;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		float lo = floor((s.Center()[i] - s.Radius()) * invCellSize);
+		float hi = floor((s.Center()[i] + s.Radius()) * invCellSize);
+
+		ClampNumber(-limit, limit, lo);
+		ClampNumber(-limit, limit, hi);
+
+		lower[i] = int32(lo);
+		upper[i] = int32(hi);
+	}
+
+}	//End: SpatialGrid::GetCellRange()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::IsLarge()
+//--------------------------------------------------------------------------------
+//		Does the cell range cover too many cells to link?
+//--------------------------------------------------------------------------------
+bool SpatialGrid::IsLarge(const int32 lower[3], const int32 upper[3]) const
+{
+	int32 count = 1;
+	for (int i = 0; i < 3; ++i)
+	{
+		int32 n = upper[i] - lower[i] + 1;
+		if (n > MAXCELLS)
+			return true;
+		count *= n;
+	}
+
+	return count > MAXCELLS;
+
+}	//End: SpatialGrid::IsLarge()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Link()
+//--------------------------------------------------------------------------------
+//		Add an entry to the cells in its range
+//--------------------------------------------------------------------------------
+void SpatialGrid::Link(uint32 e)
+{
+	const Entry& entry = entries[e];
+
+	if (entry.isLarge)
+	{
+		large.push_back(e);
+		return;
+	}
+
+	for (int32 x = entry.lower[0]; x <= entry.upper[0]; ++x)
+		for (int32 y = entry.lower[1]; y <= entry.upper[1]; ++y)
+			for (int32 z = entry.lower[2]; z <= entry.upper[2]; ++z)
+				buckets[Hash(x, y, z)].push_back(e);
+
+}	//End: SpatialGrid::Link()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Unlink()
+//--------------------------------------------------------------------------------
+//		Remove an entry from the cells in its range
+//--------------------------------------------------------------------------------
+void SpatialGrid::Unlink(uint32 e)
+{
+	const Entry& entry = entries[e];
+
+	if (entry.isLarge)
+	{
+		RemoveFrom(large, e);
+		return;
+	}
+
+	for (int32 x = entry.lower[0]; x <= entry.upper[0]; ++x)
+		for (int32 y = entry.lower[1]; y <= entry.upper[1]; ++y)
+			for (int32 z = entry.lower[2]; z <= entry.upper[2]; ++z)
+				RemoveFrom(buckets[Hash(x, y, z)], e);
+
+}	//End: SpatialGrid::Unlink()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::SetCellSize()
+//--------------------------------------------------------------------------------
+//		Set the width of a cell
+//--------------------------------------------------------------------------------
+void SpatialGrid::SetCellSize(float val)
+{
+	if (val <= EPSILON)
+		return;
+
+	for (uint32 i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i].inUse)
+			Unlink(i);
+	}
+
+	cellSize = val;
+	invCellSize = 1.0f / val;
+
+	for (uint32 i = 0; i < entries.size(); ++i)
+	{
+		Entry& entry = entries[i];
+		if (!entry.inUse)
+			continue;
+
+		GetCellRange(entry.bounds, entry.lower, entry.upper);
+		entry.isLarge = IsLarge(entry.lower, entry.upper);
+		Link(i);
+	}
+
+}	//End: SpatialGrid::SetCellSize()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Update()
+//--------------------------------------------------------------------------------
+//		Insert or move an entry
+//--------------------------------------------------------------------------------
+void SpatialGrid::Update(entityID id, Type type, const Sphere& bounds)
+{
+	int32 lower[3], upper[3];
+	GetCellRange(bounds, lower, upper);
+
+	uint64 key = Key(id, type);
+	int index = 0;
+
+	//Existing entry
+	if (lookup.find(key, index))
+	{
+		uint32 e = lookup[index];
+		Entry& entry = entries[e];
+		entry.bounds = bounds;
+
+		//Same cells, nothing to relink
+		if (lower[0] == entry.lower[0] && upper[0] == entry.upper[0] &&
+			lower[1] == entry.lower[1] && upper[1] == entry.upper[1] &&
+			lower[2] == entry.lower[2] && upper[2] == entry.upper[2])
+			return;
+
+		Unlink(e);
+		for (int i = 0; i < 3; ++i)
+		{
+			entry.lower[i] = lower[i];
+			entry.upper[i] = upper[i];
+		}
+		entry.isLarge = IsLarge(lower, upper);
+		Link(e);
+		return;
+	}
+
+	//New entry
+	uint32 e;
+	if (freeEntries.size() > 0)
+	{
+		e = freeEntries[freeEntries.size() - 1];
+		freeEntries.pop_back();
+	}
+	else
+	{
+		e = entries.size();
+		entries.push_back(Entry());
+	}
+
+	Entry& entry = entries[e];
+	entry.id = id;
+	entry.type = uint8(type);
+	entry.inUse = true;
+	entry.bounds = bounds;
+	for (int i = 0; i < 3; ++i)
+	{
+		entry.lower[i] = lower[i];
+		entry.upper[i] = upper[i];
+	}
+	entry.isLarge = IsLarge(lower, upper);
+	entry.queryStamp = 0;
+
+	Link(e);
+	lookup.insert(e, key);
+
+}	//End: SpatialGrid::Update()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Remove()
+//--------------------------------------------------------------------------------
+//		Remove entries of an entity
+//--------------------------------------------------------------------------------
+void SpatialGrid::Remove(entityID id, uint8 types)
+{
+	const uint8 allTypes[] = {POINTLIGHT, SPOTLIGHT};
+
+	for (int t = 0; t < 2; ++t)
+	{
+		if (!(types & allTypes[t]))
+			continue;
+
+		uint64 key = Key(id, allTypes[t]);
+		int index = 0;
+		if (!lookup.find(key, index))
+			continue;
+
+		uint32 e = lookup[index];
+		Unlink(e);
+		entries[e].inUse = false;
+		freeEntries.push_back(e);
+		lookup.erase(key);
+	}
+
+}	//End: SpatialGrid::Remove()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Clear()
+//--------------------------------------------------------------------------------
+//		Remove all entries
+//--------------------------------------------------------------------------------
+void SpatialGrid::Clear()
+{
+	entries.clear();
+	freeEntries.clear();
+	lookup.clear();
+	large.clear();
+
+	for (uint32 i = 0; i < NUMBUCKETS; ++i)
+		buckets[i].clear();
+
+}	//End: SpatialGrid::Clear()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Gather()
+//--------------------------------------------------------------------------------
+//		Fills candidates with entries whose sphere touches the input sphere.
+//--------------------------------------------------------------------------------
+void SpatialGrid::Gather(const Sphere& s, uint8 types) const
+{
+	candidates.clear();
+
+	//New stamp for this query
+	if (++queryStamp == 0)
+	{
+		for (uint32 i = 0; i < entries.size(); ++i)
+			entries[i].queryStamp = 0;
+		queryStamp = 1;
+	}
+
+	int32 lower[3], upper[3];
+	GetCellRange(s, lower, upper);
+	float dummy;
+
+	//Query covers too many cells, test everything
+	if (IsLarge(lower, upper))
+	{
+		for (uint32 i = 0; i < entries.size(); ++i)
+		{
+			const Entry& entry = entries[i];
+			if (entry.inUse && (entry.type & types) &&
+				TestSphereSphere(entry.bounds, s, dummy) == 1)
+				candidates.push_back(i);
+		}
+		return;
+	}
+
+	for (int32 x = lower[0]; x <= upper[0]; ++x)
+		for (int32 y = lower[1]; y <= upper[1]; ++y)
+			for (int32 z = lower[2]; z <= upper[2]; ++z)
+			{
+				const DgArray<uint32>& bucket = buckets[Hash(x, y, z)];
+				for (uint32 i = 0; i < bucket.size(); ++i)
+				{
+					const Entry& entry = entries[bucket[i]];
+					if (entry.queryStamp == queryStamp || !(entry.type & types))
+						continue;
+
+					entry.queryStamp = queryStamp;
+					if (TestSphereSphere(entry.bounds, s, dummy) == 1)
+						candidates.push_back(bucket[i]);
+				}
+			}
+
+	for (uint32 i = 0; i < large.size(); ++i)
+	{
+		const Entry& entry = entries[large[i]];
+		if ((entry.type & types) && TestSphereSphere(entry.bounds, s, dummy) == 1)
+			candidates.push_back(large[i]);
+	}
+
+}	//End: SpatialGrid::Gather()
+
+
+//--------------------------------------------------------------------------------
+//	@	SpatialGrid::Query()
+//--------------------------------------------------------------------------------
+//		Sphere query
+//--------------------------------------------------------------------------------
+void SpatialGrid::Query(const Sphere& s, uint8 types, DgArray<Item>& out) const
+{
+	Gather(s, types);
+
+	for (uint32 i = 0; i < candidates.size(); ++i)
+	{
+		const Entry& entry = entries[candidates[i]];
+		Item item;
+		item.id = entry.id;
+		item.type = entry.type;
+		out.push_back(item);
+	}
+
+}	//End: SpatialGrid::Query()
+
@@ -0,0 +1,125 @@
+/*!
+* @file SpatialGrid.h
+*
+* Class header: SpatialGrid
+*/
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "DgArray.h"
+#include "dg_map_sl.h"
+#include "DgTypes.h"
+#include "Sphere.h"
+
+/*!
+ * @ingroup entity_component
+ *
+ * @class SpatialGrid
+ *
+ * @brief Finds lights by location, using bounding spheres.
+ *
+ * Space is divided into uniform cells which are hashed into a fixed number
+ * of buckets, so the grid is unbounded and needs no rebuild as entities
+ * move. An entry is linked into every cell its sphere overlaps. Moving an
+ * entry within the same cells only updates its sphere. Entries covering
+ * too many cells are kept in a separate list that every query checks.
+ *
+ * An entity can have one entry per type.
+ */
+class SpatialGrid
+{
+public:
+
+	//! Entry types. Queries take a mask of these.
+	enum Type
+	{
+		POINTLIGHT	= 1,
+		SPOTLIGHT	= 2,
+		ALL			= 0xFF
+	};
+
+	//! Query result
+	struct Item
+	{
+		entityID id;
+		uint8 type;
+	};
+
+public:
+	//Constructor / destructor
+	SpatialGrid();
+	~SpatialGrid() {}
+
+	//Copy operations
+	SpatialGrid(const SpatialGrid&);
+	SpatialGrid& operator= (const SpatialGrid&);
+
+	//! Sets the width of a cell. Entries are relinked. Cells should be
+	//! about the size of the typical light radius.
+	void SetCellSize(float);
+
+	//! Insert an entry, or move it if it already exists.
+	void Update(entityID, Type, const Sphere&);
+
+	//! Remove the entries of this entity with a type in the mask.
+	void Remove(entityID, uint8 types = ALL);
+
+	//! Remove all entries.
+	void Clear();
+
+	//! Appends entries with a type in the mask whose sphere touches the input sphere.
+	void Query(const Sphere&, uint8 types, DgArray<Item>& out) const;
+
+private:
+
+	struct Entry
+	{
+		entityID id;
+		uint8 type;
+		bool inUse;
+		bool isLarge;
+		Sphere bounds;
+		int32 lower[3];		//Cell range
+		int32 upper[3];
+		mutable uint32 queryStamp;
+	};
+
+	//Must be a power of 2
+	static const uint32 NUMBUCKETS = 4096;
+
+	//Entries covering more cells than this go in the large list
+	static const int32 MAXCELLS = 64;
+
+private:
+	//Data members
+	float cellSize;
+	float invCellSize;
+
+	DgArray<Entry> entries;
+	DgArray<uint32> freeEntries;
+	Dg::map_sl<uint64, uint32> lookup;
+	DgArray<uint32> buckets[NUMBUCKETS];
+	DgArray<uint32> large;
+
+	//Used to return an entry only once per query
+	mutable uint32 queryStamp;
+	mutable DgArray<uint32> candidates;
+
+private:
+	//Functions
+	void init(const SpatialGrid&);
+
+	static uint64 Key(entityID id, uint8 type) {return (uint64(type) << 32) | id;}
+	static uint32 Hash(int32 x, int32 y, int32 z);
+	static void RemoveFrom(DgArray<uint32>&, uint32);
+
+	void GetCellRange(const Sphere&, int32 lower[3], int32 upper[3]) const;
+	bool IsLarge(const int32 lower[3], const int32 upper[3]) const;
+	void Link(uint32);
+	void Unlink(uint32);
+	void Gather(const Sphere&, uint8 types) const;
+
+};
+
+#endif
@@ -139,6 +139,37 @@ void Sphere::Set(const OBB& b)
 }	//End: Sphere::Set()
 
 
+//--------------------------------------------------------------------------------
+//	@	Sphere::Merge()
+//--------------------------------------------------------------------------------
+//		Grow the sphere to the smallest sphere enclosing both spheres
+//--------------------------------------------------------------------------------
+void Sphere::Merge(const Sphere& other)
+{
+	Vector4 d = other.center - center;
+	float dist2 = d.LengthSquared();
+	float dr = other.radius - radius;
+
+	//One sphere encloses the other
+	if (dr*dr >= dist2)
+	{
+		if (other.radius > radius)
+		{
+			center = other.center;
+			radius = other.radius;
+		}
+		return;
+	}
+
+	float dist = DgSqrt(dist2);
+	float new_radius = (dist + radius + other.radius) * 0.5f;
+
+	center += d * ((new_radius - radius) / dist);
+	radius = new_radius;
+
+}	//End: Sphere::Merge()
+
+
 //--------------------------------------------------------------------------------
 //	@	Sphere::ClosestPoint()
 //--------------------------------------------------------------------------------
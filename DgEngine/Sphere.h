@@ -58,6 +58,7 @@ public:
 	inline void SetRadius(float val);
 	inline void Set(const Point4&, float val);
 	void Set(const OBB&);
+	void Merge(const Sphere&);		//Grow to enclose another sphere
 
 	//Return functions
 	const Point4& Center()	const {return center;}
@@ -45,6 +45,11 @@ public:
 	SpotLight(const SpotLight& other);
 	SpotLight& operator= (const SpotLight&);
 
+	//! Compares color, intensity and cones.
+	bool operator== (const SpotLight& other) const
+	{return Light::operator==(other) && cosInner == other.cosInner && cone == other.cone;}
+	bool operator!= (const SpotLight& other) const {return !(*this == other);}
+
 	/*!
 	* @brief Creates a deep copy of a derived object.
 	*
@@ -43,9 +43,16 @@ void ChangeState(StateInfo& stateinfo, GameState*& currentstate)
 			break;
 
 		case STATE_OVERWORLD:
-			currentstate = new Overworld();
+		{
+			Overworld* world = new Overworld();
+			currentstate = world;
+
+			//Nothing to play without a level
+			if (!world->IsLoaded())
+				stateinfo.nextstate = STATE_EXIT;
 			break;
 		}
+		}
 
 		//Change the current StateID
 		stateinfo.stateID = stateinfo.nextstate;
@@ -13,7 +13,6 @@
 //================================================================================
 
 #include "Text.h"
-#include "SDL_ttf.h"
 #include "CommonGraphics.h"
 #include "Dg_io.h"
 #include "SDL.h"
@@ -46,7 +45,7 @@ static const float			DEF_tab		= 4.0f;
 //		Constructor
 //--------------------------------------------------------------------------------
 Text::Text() : size(DEF_size), name(DEF_name), clr(DEF_clr), x(DEF_xy), y(DEF_xy), 
-	str(DEF_string), spacing(DEF_spacing), tab(DEF_tab)
+	str(DEF_string), spacing(DEF_spacing), tab(DEF_tab), fontHandle(NO_FONT), atlas(NULL)
 {
 	//Generate images
 	GenerateImages();
@@ -60,7 +59,8 @@ Text::Text() : size(DEF_size), name(DEF_name), clr(DEF_clr), x(DEF_xy), y(DEF_xy
 //		Constructor
 //--------------------------------------------------------------------------------
 Text::Text(std::string _name, uint16 _size, Color _clr) :size(_size), name(_name), 
-clr(_clr), x(DEF_xy), y(DEF_xy), str(DEF_string), spacing(DEF_spacing), tab(DEF_tab)
+clr(_clr), x(DEF_xy), y(DEF_xy), str(DEF_string), spacing(DEF_spacing), tab(DEF_tab),
+fontHandle(NO_FONT), atlas(NULL)
 {
 	//Generate new image
 	GenerateImages();
@@ -84,10 +84,10 @@ Text::~Text()
 //		Copy constructor
 //--------------------------------------------------------------------------------
 Text::Text(const Text& t) : size(t.size), name(t.name), clr(t.clr), 
-	spacing(t.spacing), tab(t.tab), x(t.x), y(t.y), str(t.str)
+	spacing(t.spacing), tab(t.tab), x(t.x), y(t.y), str(t.str), fontHandle(t.fontHandle), atlas(t.atlas)
 {
 	//Copy parameters
-	images = t.images;
+	glyphs = t.glyphs;
 	
 }	//End: Text::Text()
 
@@ -104,9 +104,11 @@ Text& Text::operator=(const Text& t)
 		return *this;
 
 	//Copy parameters
-	images = t.images;
+	glyphs = t.glyphs;
+	atlas = t.atlas;
 	size = t.size;
 	name = t.name;
+	fontHandle = t.fontHandle;
 	clr = t.clr;
 	spacing = t.spacing;
 	tab = t.tab;
@@ -122,71 +124,70 @@ Text& Text::operator=(const Text& t)
 //--------------------------------------------------------------------------------
 //	@	Text::GenerateImages()
 //--------------------------------------------------------------------------------
-//		Generate a new series of text images. Image list is cleared if
+//		Lay out the string from the glyph atlas. Glyph list is cleared if
 //		font failed to load.
 //--------------------------------------------------------------------------------
 void Text::GenerateImages()
 {
-	//GetFont
-	TTF_Font* font = fontlist.GetFont(name, size);
+	//Free old glyphs, keeping the memory
+	glyphs.clear();
 
-	if (font == NULL)
+	//Get the atlas. The name is only looked up when the font changes.
+	if (fontHandle == NO_FONT)
+	{
+		fontHandle = fontlist.GetHandle(name, size);
+		atlas = NULL;
+	}
+
+	if (atlas == NULL)
+		atlas = fontlist.GetAtlas(fontHandle);
+
+	if (atlas == NULL)
 	{
         std::cerr << "@Text::GenerateImages() -> Failed to load font: " << name << std::endl;
 		return;
 	}
-
-	//Free old images
-	images.clear();
 	
 	//Get pixel values for tab and spacing
-	uint16 tab_p = uint16(float(size)*tab);
-	uint16 spacing_p = uint16(float(size)*spacing);
+	int32 tab_p = int32(float(size)*tab);
+	int32 spacing_p = int32(float(size)*spacing);
 
-	//Break the string up
-	DgString all(str);			//Get string as an instream
-	std::string line, group;	//used to get a line or a tab group
-	int yval = y;				//Current height of the group of text
+	int32 xval = x;				//Pen position
+	int32 yval = y;				//Top of the current line
+	bool groupEmpty = true;		//No letters since the last tab or line
 
-	//Get next complete line of text each iteration
-	while (std::getline(all, line))	
+	for (size_t i = 0; i < str.size(); ++i)
 	{
-		//Reset current x coordinate of the group
-		int xval = x;
+		char c = str[i];
 
-		DgString current(line);
-
-		//Get text up to next tab, if one exists, otherwise whole line
-		while (std::getline(current, group, '\t'))	
+		if (c == '\n')
+		{
+			xval = x;
+			yval += spacing_p;
+			groupEmpty = true;
+		}
+		else if (c == '\t')
 		{
-			//Tabs, but no letters
-			if (group == "")
-			{
-				//Increment x to next tab space
+			//Tabs with no letters move a whole tab space, otherwise move to 
+			//the next tab space
+			if (groupEmpty)
 				xval += tab_p;
-				continue;
-			}
-			
-			//Find x, y coordinates of the group...
-
-			//Create textline
-			impl::Word temp_textline;
-			
-			//Create a new image
-			temp_textline.surface.Set(TTF_RenderText_Blended(font, group.c_str(), clr), true);
-
-			temp_textline.x = xval;
-			temp_textline.y = yval;
+			else
+				xval = (xval/tab_p)*tab_p + tab_p;
 
-			//Increment x to next tab space
-			xval = ((xval + temp_textline.surface.w())/tab_p)*tab_p + tab_p;
-
-			//Add to images
-			images.push_back(temp_textline);
+			groupEmpty = true;
+		}
+		else
+		{
+			impl::GlyphQuad quad;
+			quad.glyph = &atlas->GetGlyph(c);
+			quad.x = xval;
+			quad.y = yval;
+			glyphs.push_back(quad);
+
+			xval += quad.glyph->advance;
+			groupEmpty = false;
 		}
-
-		//Increment yval
-		yval += spacing_p;
 	}
 
 }	//End: Text::GenerateImages()
@@ -201,6 +202,7 @@ void Text::SetFont(std::string newfont)
 {
 	//Assign new name
 	name = newfont;
+	fontHandle = NO_FONT;
 
 	//Generate new image
 	GenerateImages();
@@ -217,6 +219,7 @@ void Text::SetSize(uint16 newsize)
 {
 	//Assign new size and spacing
 	size = newsize;
+	fontHandle = NO_FONT;
 
 	//Generate new image
 	GenerateImages();
@@ -231,12 +234,9 @@ void Text::SetSize(uint16 newsize)
 //--------------------------------------------------------------------------------
 void Text::SetColor(Color newclr)
 {
-	//Set new color
+	//Set new color. Glyphs are colored when drawn.
 	clr = newclr;
 
-	//Generate new image
-	GenerateImages();
-
 }	//End: Text::SetColor()
 
 
@@ -251,10 +251,10 @@ void Text::SetPosition(int newx, int newy)
 	int xdif = newx - x;
 	int ydif = newy - y;
 
-	for (unsigned int i = 0; i < images.size(); i++)
+	for (unsigned int i = 0; i < glyphs.size(); i++)
 	{
-		images[i].x += xdif;
-		images[i].y += ydif;
+		glyphs[i].x += xdif;
+		glyphs[i].y += ydif;
 	}
 
 	x = newx;
@@ -337,11 +337,9 @@ void Text::SetTab(float new_tab)
 //--------------------------------------------------------------------------------
 void Text::Draw(Image& dest) const
 {
-	for (unsigned int i = 0; i < images.size(); i++)
+	for (unsigned int i = 0; i < glyphs.size(); i++)
 	{
-		ApplyImage(	images[i].surface, dest,
-					images[i].x, images[i].y, 
-					DgGraphics::BlendType::ALPHA);
+		atlas->Draw(*glyphs[i].glyph, dest, glyphs[i].x, glyphs[i].y, clr);
 	}
 
 }	//End: Text::Draw()
@@ -354,11 +352,13 @@ void Text::Draw(Image& dest) const
 //--------------------------------------------------------------------------------
 void Text::Draw(Viewport& dest) const
 {
-	for (unsigned int i = 0; i < images.size(); i++)
+	Draw(dest.Viewpane());
+
+	//Log the pixels covered
+	for (uint32 i = 0; i < glyphs.size(); ++i)
 	{
-		dest.BlitImage(	images[i].surface,
-						images[i].x, images[i].y, 
-						DgGraphics::BlendType::ALPHA);
+		const GlyphAtlas::Glyph& g = *glyphs[i].glyph;
+		dest.MarkDrawn(DgRect(glyphs[i].x + g.xoff, glyphs[i].y + g.yoff, g.w, g.h));
 	}
 
 }	//End: Text::Draw()
@@ -376,12 +376,7 @@ void Text::Draw(viewportID id) const
 	if (dest == NULL)
 		return;
 
-	for (unsigned int i = 0; i < images.size(); i++)
-	{
-		dest->BlitImage(images[i].surface,
-			images[i].x, images[i].y,
-			DgGraphics::BlendType::ALPHA);
-	}
+	Draw(*dest);
 
 }	//End: Text::Draw()
 
@@ -389,29 +384,31 @@ void Text::Draw(viewportID id) const
 //--------------------------------------------------------------------------------
 //	@	Text::GetBounds()
 //--------------------------------------------------------------------------------
-//		Returns the bounds of the text object
+//		Returns the bounds of the text object. Each glyph spans its advance
+//		and the height of the line.
 //--------------------------------------------------------------------------------
 DgRect Text::GetBounds() const
 {
-	if (images.empty())
+	if (glyphs.empty())
 		return DgRect(0,0,1,1);
 
-	int32 xmin = images[0].x;
-	int32 ymin = images[0].y;
-	int32 xmax = xmin + images[0].surface.w();
-	int32 ymax = ymin + images[0].surface.h();
+	int32 lineHeight = atlas->LineHeight();
+	int32 xmin = glyphs[0].x;
+	int32 ymin = glyphs[0].y;
+	int32 xmax = xmin + glyphs[0].glyph->advance;
+	int32 ymax = ymin + lineHeight;
 
-	//loop through all words to find bounds
-	for (uint32 i = 1; i < images.size(); ++i)
+	//loop through all glyphs to find bounds
+	for (uint32 i = 1; i < glyphs.size(); ++i)
 	{
-		if (images[i].x < xmin)
-			xmin = images[i].x;
-		if (images[i].y < ymin)
-			ymin = images[i].y;
-		if (images[i].x + int32(images[i].surface.w()) > xmax)
-			xmax = images[i].x + int32(images[i].surface.w());
-		if (images[i].y + int32(images[i].surface.h()) > ymax)
-			ymax = images[i].y + int32(images[i].surface.h());
+		if (glyphs[i].x < xmin)
+			xmin = glyphs[i].x;
+		if (glyphs[i].y < ymin)
+			ymin = glyphs[i].y;
+		if (glyphs[i].x + glyphs[i].glyph->advance > xmax)
+			xmax = glyphs[i].x + glyphs[i].glyph->advance;
+		if (glyphs[i].y + lineHeight > ymax)
+			ymax = glyphs[i].y + lineHeight;
 	}
 
 	return DgRect(xmin, ymin, (xmax - xmin), (ymax - ymin));
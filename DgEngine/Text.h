@@ -18,6 +18,7 @@
 
 #include "Color.h"
 #include "FontManager.h"
+#include "GlyphAtlas.h"
 #include "Image.h"
 #include "DgTypes.h"
 #include "Dg_io.h"
@@ -30,22 +31,14 @@ typedef struct _TTF_Font TTF_Font;
 struct DgRect;
 
 //--------------------------------------------------------------------------------
-//		One 'word' of text. Lines of text are broken up into words. 
-//		Characters that break up words are tab and new line.
+//		One character of text, placed at its pen position and line top.
 //--------------------------------------------------------------------------------
 namespace impl
 {
-	struct Word
+	struct GlyphQuad
 	{
-		//Constructors
-		Word(){}
-		Word(const Image& g, int _x, int _y) : surface(g), x(_x), y(_y) {}
-		~Word(){}
-
-		//Data members
-		Image surface;
-		int x, y;
-
+		const GlyphAtlas::Glyph* glyph;
+		int32 x, y;
 	};
 }
 
@@ -102,12 +95,14 @@ private:
 	float spacing;					//Line spacing
 	float tab;						//Tab size
 
-	//The lines of text
-	std::vector<impl::Word> images;	//list of all images
+	//The laid out text. Kept between strings so regenerating does not allocate.
+	std::vector<impl::GlyphQuad> glyphs;
+	const GlyphAtlas* atlas;			//Of the font, owned by fontlist
 
 	//Font parameters
 	uint16 size;
 	std::string name;	//Name of the font
+	impl::FontManager::Handle fontHandle;	//Font of name and size, once looked up
 
 	//--------------------------------------------------------------------------------
 	//		Functions
@@ -119,6 +114,7 @@ private:
 
 	//Resource manager
 	static impl::FontManager fontlist;
+	static const impl::FontManager::Handle NO_FONT = ResourceRegistry<impl::ttf>::INVALID;
 
 };
 
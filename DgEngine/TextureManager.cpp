@@ -26,51 +26,37 @@
 //--------------------------------------------------------------------------------
 bool TextureManager::LoadDocument(std::string file)
 {
-	//Open file
-	return document.load_file(file.c_str());
-
-}	//End: TextureManager::LoadDocument()
+	nodes.clear();
 
+	//Open file
+	if (!document.load_file(file.c_str()))
+		return false;
 
-//--------------------------------------------------------------------------------
-//	@	TextureManager::AddTexture()
-//--------------------------------------------------------------------------------
-//		Add a texture to the list. Returns pointer to the added texture.
-//--------------------------------------------------------------------------------
-const Texture* TextureManager::AddTexture(const Texture& t, uint32 id)
-{
-	//Add to list
-	texture_list.insert(t, id);
+	//Index the texture nodes by id, so a miss does not walk the document
+	pugi::xml_node rootNode = document.document_element();
+	for (pugi::xml_node_iterator it = rootNode.begin(); it != rootNode.end(); ++it)
+	{
+		nodes.insert(std::make_pair(std::string(it->attribute("id").value()), *it));
+	}
 
-	//Return pointer to last element
-	return texture_list.back();
+	return true;
 
-}	//End: TextureManager::AddTexture()
+}	//End: TextureManager::LoadDocument()
 
 
 //--------------------------------------------------------------------------------
 //	@	TextureManager::operator[]
 //--------------------------------------------------------------------------------
-//		Searches texturelist for a texture. Returns NULL of texture 'tag'
-//		could not be loaded.
+//		Return a texture, loading it on first use. Returns the default 
+//		texture if it could not be loaded.
 //--------------------------------------------------------------------------------
-const Texture* TextureManager::operator[](const std::string& tag)
+const Texture* TextureManager::operator[](Handle h)
 {
-	std::list<Texture_string>::iterator it = texture_list.begin();
-
-	//find element
-	for (it; it != texture_list.end(); it++)
-	{
-		if (it->second == tag)
-		{
-			//If the texture has been found
-			return it->first;
-		}
-	}
+	const Texture* texture = textures.Get(h);
+	if (texture != NULL)
+		return texture;
 
-	//If image not found,
-	//Try to load the image
-	return Load(tag);
+	return Load(h);
 	
 }	//End:TextureManager::operator[]
 
@@ -78,46 +64,40 @@ const Texture* TextureManager::operator[](const std::string& tag)
 //--------------------------------------------------------------------------------
 //	@	TextureManager::Load
 //--------------------------------------------------------------------------------
-//		Load a texture into texture_list
+//		Load a texture into the registry. A texture which is not in the
+//		document is registered as a copy of the default texture, so it
+//		is only searched for once.
 //--------------------------------------------------------------------------------
-const Texture* TextureManager::Load(const std::string& input)
+const Texture* TextureManager::Load(Handle h)
 {
-	//Get the root node
-	pugi::xml_node rootNode = document.document_element();
-
-	//iterate through all nodes
-	for (pugi::xml_node_iterator it = rootNode.begin(); it != rootNode.end(); ++it)
+	std::unordered_map<std::string, pugi::xml_node>::const_iterator it = 
+		nodes.find(textures.Name(h));
+	if (it != nodes.end())
 	{
 		//Get the name of the node
-		std::string tag = it->name();
+		std::string tag = it->second.name();
 
 		if (tag == "single")
 		{
-			if (!(it->attribute("id").value() == input))
-				continue;
-
 			//Read texture
-			Texture_S temp_s;
-			Read(*it, temp_s, IMAGE_MANAGER);
+			Texture_S* temp_s = new Texture_S();
+			Read(it->second, *temp_s, *global::IMAGE_MANAGER);
 
 			//Add to list and return
-			return AddTexture(temp_s, input);
+			return textures.Set(h, temp_s);
 		}
 		else if (tag == "animated")
 		{
-			if (!(it->attribute("id").value() == input))
-				continue;
-
 			//Read texture
-			Texture_A temp_a;
-			Read(*it, temp_a, IMAGE_MANAGER);
+			Texture_A* temp_a = new Texture_A();
+			Read(it->second, *temp_a, *global::IMAGE_MANAGER);
 
 			//Add to list and return
-			return AddTexture(temp_a, input);
+			return textures.Set(h, temp_a);
 		}
 	}
 	
-	return &DEFAULT_TEXTURE_S;
+	return textures.Set(h, defaultTextureS.clone());
 
 }	//End: TextureManager::Load()
 
@@ -125,25 +105,13 @@ const Texture* TextureManager::Load(const std::string& input)
 //--------------------------------------------------------------------------------
 //	@	TextureManager::Find()
 //--------------------------------------------------------------------------------
-//		Find a specific node in the document. Only searched nodes in the root.
+//		Find a specific node in the document. Only nodes in the root are indexed.
 //--------------------------------------------------------------------------------
 const pugi::xml_node TextureManager::Find(std::string type, std::string id) const
 {
-	//Get the root node
-	pugi::xml_node rootNode = document.document_element();
-
-	//iterate through all nodes
-	for (pugi::xml_node_iterator it = rootNode.begin(); it != rootNode.end(); ++it)
-	{
-		//Get the name of the node
-		std::string tag = it->name();
-
-		if (tag == type)
-		{
-			if ((it->attribute("id").value() == id))
-				return *it;
-		}
-	}
+	std::unordered_map<std::string, pugi::xml_node>::const_iterator it = nodes.find(id);
+	if (it != nodes.end() && type == it->second.name())
+		return it->second;
 
 	//Return the null node
 	pugi::xml_node failed;
@@ -21,12 +21,12 @@
 #define TEXTURE_MANAGER_H
 
 #include <string>
-#include "BaseWrapper.h"
+#include <unordered_map>
 #include "Texture.h"
 #include "pugixml.hpp"
 #include "Texture_S.h"
 #include "Mipmap.h"
-#include "dg_map.h"
+#include "ResourceRegistry.h"
 
 
 //--------------------------------------------------------------------------------
@@ -35,17 +35,22 @@
 class TextureManager
 {
 public:
+	typedef ResourceRegistry<Texture>::Handle Handle;
 
 	//Constructor/destructor
   TextureManager() : defaultTextureS(){}
 	~TextureManager() {}
 
-	//Find and return a texture
-	const Texture& operator[](uint32 id);
+	//Get the handle of a texture, to look it up quickly later
+	Handle GetHandle(const std::string& id) {return textures.Intern(id);}
+
+	//Find and return a texture, loading it if needed
+	const Texture* operator[](Handle);
+	const Texture* operator[](const std::string& id) {return (*this)[GetHandle(id)];}
 
 	//Find and return a specific texture xml node
 	const pugi::xml_node Find(std::string type, std::string id) const;
-	void clear() {texture_list.clear();}
+	void clear() {textures.ReleaseAll();}
 
 	//Load Resources. Input is the xml texture file.
 	//Returns true for successful load.
@@ -54,7 +59,7 @@ public:
 private:
 
 	//Data members
-  Dg::map<uint32, BaseWrapper<Texture>> texture_list;	//The list of textures
+	ResourceRegistry<Texture> textures;	//Loaded textures, by id
 
 	/*!
 	 * A valid texture must always be returned. If there was an error finding or
@@ -64,16 +69,14 @@ private:
 	
 	//Resources
 	pugi::xml_document document;
+	std::unordered_map<std::string, pugi::xml_node> nodes;	//Root nodes by id
 
 	//--------------------------------------------------------------------------------
 	//		Functions
 	//--------------------------------------------------------------------------------
 
 	//Load a texture
-	const Texture* TextureManager::Load(const std::string&);
-
-	//Manipulators
-	const Texture* AddTexture(const Texture& t, uint32 id);
+	const Texture* Load(Handle);
 
 	//DISALLOW COPY AND ASSIGNMENT
 	TextureManager(const TextureManager&);
@@ -18,10 +18,12 @@
 #include "Rasterizer.h"
 #include "WindowManager.h"
 #include "TextureManager.h"
-#include "Mesh_list.h"
+#include "Mesh_List.h"
 #include "ImageManager.h"
 #include "ViewportHandler.h"
 #include "GameDatabase.h"
+#include "AssetArchive.h"
+#include "ResourceLoader.h"
 #include <string>
 
 #include <xercesc/parsers/XercesDOMParser.hpp>
@@ -38,6 +40,10 @@ bool InitializeWindow();
 //		Initiate all systems
 //--------------------------------------------------------------------------------
 /*!
+ * - Read settings, then command line overrides
+ * - Open the asset archive
+ * - Index the image manifest
+ * - Start the background resource loader
  * - Set random seed
  * - Initialize all SDL systems
  * - Initialize SDL true type fonts
@@ -46,7 +52,7 @@ bool InitializeWindow();
  * - Load Texture file
  * - Load Debugger file
  */
-bool START()
+bool START(int argc, char* argv[])
 {
     //Initialise objects needed for schema validation
     xercesc::XMLPlatformUtils::Initialize();
@@ -59,19 +65,64 @@ bool START()
 
     //Parse settings file
     global::SETTINGS->Load("setup.ini");
+    global::SETTINGS->ParseArgs(argc, argv);
+
+    //Open the asset archive. Assets not in the archive are loaded from files.
+    global::ASSETS = new AssetArchive();
+    std::string archive;
+    if (global::SETTINGS->GetValue("asset_archive", archive) && 
+        !global::ASSETS->Open(archive))
+    {
+        std::cerr << "@START() -> Could not open asset archive: " << archive << std::endl;
+    }
+
+    //Texture memory budget
+    std::string budget;
+    uint32 budgetMB = 0;
+    if (global::SETTINGS->GetValue("texture_budget_mb", budget))
+    {
+        StringToNumber(budgetMB, budget, std::dec);
+        global::IMAGE_MANAGER->SetBudget(size_t(budgetMB) << 20);
+    }
+
+    //Index the image manifest
+    if (!global::IMAGE_MANAGER->SetDataFile(ImageManager::s_manifestPath))
+    {
+        std::cerr << "@START() -> Could not load image manifest: " 
+          << ImageManager::s_manifestPath << std::endl;
+    }
+
+    //Start the background loader
+    global::LOADER = new ResourceLoader();
 
     if (!GameDatabase::GlobalInit())
     {
       return false;
     }
 
-	//Seed the random number generator
-	SimpleRNG::SetSeedFromSystemTime();
+	//Seed the random number generator. A fixed seed gives repeatable runs.
+    std::string seed;
+    uint32 seedValue = 0;
+    if (global::SETTINGS->GetValue("rng_seed", seed) && StringToNumber(seedValue, seed, std::dec))
+    {
+        SimpleRNG::SetSeed(seedValue);
+    }
+    else
+    {
+        SimpleRNG::SetSeedFromSystemTime();
+    }
+
+	//Initialize all SDL subsystems. Headless runs need no display or audio.
+    std::string str;
+    Uint32 sdlFlags = SDL_INIT_EVERYTHING;
+    if (global::SETTINGS->GetValue("headless", str) && ToBool(str))
+    {
+        sdlFlags = SDL_INIT_TIMER | SDL_INIT_EVENTS;
+    }
 
-	//Initialize all SDL subsystems
-    if (SDL_Init(SDL_INIT_EVERYTHING) == -1)
+    if (SDL_Init(sdlFlags) == -1)
     {
-        std::cerr << "@START() -> Fail: SDL_Init(SDL_INIT_EVERYTHING)" << std::endl;
+        std::cerr << "@START() -> Fail: SDL_Init(" << sdlFlags << ")" << std::endl;
         return false;
     }
 
@@ -129,7 +180,26 @@ static bool InitializeWindow()
         StringToNumber(w, str, std::dec);
     }
 
-	global::WINDOW = new WindowManager(	w, h, fullscreen, "My Game");
+	//Render to memory only?
+    bool headless = false;
+    if (global::SETTINGS->GetValue("headless", str))
+    {
+        headless = ToBool(str);
+    }
+
+	global::WINDOW = new WindowManager(	w, h, fullscreen, "My Game", headless);
+
+    //Rasterize into the window texture rather than copying to it
+    if (global::SETTINGS->GetValue("zero_copy_present", str))
+    {
+        global::WINDOW->SetZeroCopy(ToBool(str));
+    }
+
+    //Present on a thread of its own
+    if (global::SETTINGS->GetValue("async_present", str))
+    {
+        global::WINDOW->SetAsyncPresent(ToBool(str));
+    }
 
     //If everything initialized fine
     return true;
@@ -150,6 +220,10 @@ static bool InitializeWindow()
  */
 void SHUTDOWN()
 {
+  //Finish background loads while the managers still exist
+  delete global::LOADER;
+  global::LOADER = NULL;
+
   GameDatabase::GlobalShutDown();
 
 	//Clear all resources
@@ -164,6 +238,7 @@ void SHUTDOWN()
   delete global::TEXTURE_MANAGER;
   delete global::MESH_MANAGER;
   delete global::SETTINGS;
+  delete global::ASSETS;
 
   //Quit SDL
   SDL_Quit();
@@ -12,6 +12,8 @@
 
 #include "DgTypes.h"
 
+class SettingsParser;
+
 //--------------------------------------------------------------------------------
 //	@	START()
 //--------------------------------------------------------------------------------
@@ -20,9 +22,12 @@
  *
  * @brief Start all systems.
  *
+ * Settings are read from setup.ini, then overridden from the command line
+ * as --tag=value.
+ *
  * @return Returns true if successful initialization of all systems.
  */
-bool START();
+bool START(int argc, char* argv[]);
 
 
 //--------------------------------------------------------------------------------
@@ -36,6 +41,87 @@ bool START();
 void SHUTDOWN();
 
 
+//--------------------------------------------------------------------------------
+//	@	RUN_HEADLESS()
+//--------------------------------------------------------------------------------
+/*!
+ * @ingroup utility_system
+ *
+ * @brief Render the overworld offscreen and write each frame out.
+ *
+ * Time advances by a fixed step, so a run gives the same frames each time.
+ * Read from settings:
+ *
+ *     headless_frames       Frames to render. Default: the length of the
+ *                           camera path, else 1.
+ *     headless_fps          Frames per second of game time. Default: 60.
+ *     headless_camera_path  File of a CameraPath for the player to follow.
+ *     headless_output       Where frames are written, see FrameWriter.
+ *                           Default: none.
+ *     headless_format       ppm, png or raw. Default: ppm.
+ *     benchmark_output      File to write frame and stage times to as JSON,
+ *                           "-" for stdout. Default: none.
+ *     benchmark_warmup      Frames rendered before timing starts, fewer
+ *                           than headless_frames. Default: 10.
+ *
+ * Background loads are finished at the start of each frame. Set rng_seed
+ * as well for runs to be repeatable.
+ *
+ *     raster_capture        File to save the draw stream of one frame to,
+ *                           see RasterCapture. Default: none.
+ *     raster_capture_frame  Frame to capture. Default: the last.
+ *
+ * @return Returns 0 if all frames were rendered and written.
+ */
+int RUN_HEADLESS();
+
+
+//--------------------------------------------------------------------------------
+//	@	RUN_RASTER_REPLAY()
+//--------------------------------------------------------------------------------
+/*!
+ * @ingroup utility_system
+ *
+ * @brief Draw a saved raster capture repeatedly and report its speed.
+ *
+ * Needs none of the other systems started. Read from options:
+ *
+ *     raster_replay             The capture file.
+ *     raster_replay_iterations  Times to draw it. Default: 100.
+ *     raster_replay_output      Where to write the image drawn, see
+ *                               FrameWriter. Default: none.
+ *     raster_replay_format      ppm, png or raw. Default: ppm.
+ *
+ * Triangles, particles and pixels per second are written to stdout as
+ * JSON. Pixels are the screen area of everything drawn.
+ *
+ * @return Returns 0 if the capture was read and drawn.
+ */
+int RUN_RASTER_REPLAY(const SettingsParser& options);
+
+
+//--------------------------------------------------------------------------------
+//	@	RUN_PACK()
+//--------------------------------------------------------------------------------
+/*!
+ * @ingroup utility_system
+ *
+ * @brief Cook assets and pack them into an asset archive.
+ *
+ * Packs every image in the image manifest, and the meshes used by a level,
+ * its class file and the skybox. Stale or missing cooked files are cooked
+ * first. Needs none of the other systems started. Read from options:
+ *
+ *     pack     The archive to write.
+ *     level    The level whose meshes are packed. Default: gamma.xml.
+ *
+ * Point the asset_archive setting at the archive to load from it.
+ *
+ * @return Returns 0 if the archive was written.
+ */
+int RUN_PACK(const SettingsParser& options);
+
+
 //--------------------------------------------------------------------------------
 //	@	RESIZE_WINDOW()
 //--------------------------------------------------------------------------------
@@ -41,6 +41,30 @@ VQS& VQS::operator=(const VQS& g)
 }	//End: VQS::operator=();
 
 
+//--------------------------------------------------------------------------------
+//	@	VQS::operator==()
+//--------------------------------------------------------------------------------
+//		Comparison operator
+//--------------------------------------------------------------------------------
+bool VQS::operator==(const VQS& g) const
+{
+	return (v == g.v && q == g.q && DgAreEqual(s, g.s));
+
+}	//End: VQS::operator==();
+
+
+//--------------------------------------------------------------------------------
+//	@	VQS::operator!=()
+//--------------------------------------------------------------------------------
+//		Comparison operator
+//--------------------------------------------------------------------------------
+bool VQS::operator!=(const VQS& g) const
+{
+	return !(*this == g);
+
+}	//End: VQS::operator!=();
+
+
 
 //--------------------------------------------------------------------------------
 //	@	operator>>()
@@ -49,6 +49,10 @@ public:
 	//Copy operations
 	VQS(const VQS& g): v(g.v), q(g.q), s(g.s) {}
 	VQS& operator=(const VQS&);
+
+	//Comparison
+	bool operator==(const VQS&) const;
+	bool operator!=(const VQS&) const;
 	
 	//Input
 	friend DgReader& operator>>(DgReader& in, VQS& dest);
@@ -46,6 +46,8 @@ Viewport::Viewport(): dist(1.0f), wsc(0.0f), hsc(0.0f), near_clip(1.0f),
 //--------------------------------------------------------------------------------
 void Viewport::init(const Viewport& other)
 {
+	DetachOutput();
+
 	//Copy data
 	flags = other.flags;
 
@@ -54,6 +56,8 @@ void Viewport::init(const Viewport& other)
 	rasterizer = other.rasterizer;
 
 	viewpane = other.viewpane;
+	drawn = other.drawn;
+	cleared = other.cleared;
 
 	blend = other.blend;
 	
@@ -80,7 +84,7 @@ void Viewport::init(const Viewport& other)
 
 	//Functions
 	zBuffer.resize(viewpane.w() * viewpane.h());
-	rasterizer.SetOutput(viewpane, zBuffer);
+	rasterizer.SetOutput(viewpane, zBuffer, &drawn);
 
 }	//End: Viewport::init()
 
@@ -204,6 +208,8 @@ void Viewport::UpdateSize(uint32 _parent_w, uint32 _parent_h)
 		return;
 	}
 
+	DetachOutput();
+
 	//Assign data
 	parent_w = _parent_w;
 	parent_h = _parent_h;
@@ -221,6 +227,9 @@ void Viewport::UpdateSize(uint32 _parent_w, uint32 _parent_h)
 	//Set viewpane size
 	::Resize(viewpane, new_h, new_w);
 	viewpane.Flush();
+	drawn.SetBounds(new_w, new_h);
+	cleared.SetBounds(new_w, new_h);
+	cleared.AddAll();
 	
 	//Clear masterPList
 	masterPList.Reset();
@@ -229,7 +238,7 @@ void Viewport::UpdateSize(uint32 _parent_w, uint32 _parent_h)
 	zBuffer.resize(new_h*new_w);
 
 	//Set rasterizer
-	rasterizer.SetOutput(viewpane, zBuffer);
+	rasterizer.SetOutput(viewpane, zBuffer, &drawn);
 
 	//Set projections data.
 	SetProjectionData();
@@ -259,6 +268,44 @@ void Viewport::Initialise(const Frustum& f, float _cam_wd2,
 }	//End: Viewport::Initialise()
 
 
+//--------------------------------------------------------------------------------
+//	@	Viewport::CullObject()
+//--------------------------------------------------------------------------------
+//		Deactivate polygons that lie completely outside a clipping plane,
+//		along with any vertices only they reference. Call this before 
+//		per-vertex work such as lighting so it is not done for vertices that
+//		never reach the master polygon list.
+//		Pre:	Active vertices have been transformed to camera space.
+//--------------------------------------------------------------------------------
+void Viewport::CullObject(Mesh* mesh, uint8 planes)
+{
+	//Nothing to reject
+	if (planes == Frustum::INSIDE || planes == Frustum::OUTSIDE)
+		return;
+
+	//Extract polygon list.
+	DgArray<Polygon>& polygons = mesh->GetPolygons();
+
+	bool culled = false;
+	for (uint32 i = 0; i < polygons.size(); ++i)
+	{
+		//Check state
+		if (polygons[i].state == 'x')
+			continue;
+
+		if (clipper.IsOutside(polygons[i], planes))
+		{
+			polygons[i].state = 'x';
+			culled = true;
+		}
+	}
+
+	if (culled)
+		mesh->UpdateVertexStates();
+
+}	//End: Viewport::CullObject()
+
+
 //--------------------------------------------------------------------------------
 //	@	Viewport::AddObject()
 //--------------------------------------------------------------------------------
@@ -514,6 +561,20 @@ void Viewport::ProjectFromClipper(Clipper::Point* start, uint8 size)
 //--------------------------------------------------------------------------------
 void Viewport::Reset(bool clearVP)
 {
+	//The attached pixels are the frame on the window. The viewpane itself
+	//has not been drawn to while the output was attached.
+	if (IsAttached())
+	{
+		DetachOutput();
+		clearVP = false;
+	}
+
+	if (clearVP)
+	{
+		cleared.Add(drawn);
+		drawn.Clear();
+	}
+
 	//Clear ZBuffer
 	int32* zbuf(zBuffer.Data());
 	uint32 zbuf_size = zBuffer.max_size();
@@ -549,6 +610,7 @@ void Viewport::BlitImage(const Image& img, int32 atX, int32 atY,
 						 DgGraphics::BlendType b)
 {
 	ApplyImage(img, viewpane, atX, atY, b);
+	drawn.Add(DgRect(atX, atY, img.w(), img.h()));
 
 }	//End: Viewport::BlitImage()
 
@@ -561,6 +623,7 @@ void Viewport::BlitImage(const Image& img, int32 atX, int32 atY,
 void Viewport::DrawMessageBox(const MessageBox& m)
 {
 	m.Draw(viewpane);
+	drawn.Add(m.GetBounds());
 
 }	//End: Viewport::BlitImage()
 
@@ -611,6 +674,7 @@ void Viewport::MaskOut(DgRect rect)
 void Viewport::BlitToRenderer(Viewport& dest) const
 {
 	ApplyImage(viewpane, dest.viewpane, absolute_x, absolute_y, blend);
+	dest.drawn.Add(DgRect(absolute_x, absolute_y, viewpane.w(), viewpane.h()));
 
 }	//End: Viewport::BlitTo()
 
@@ -627,6 +691,44 @@ void Viewport::BlitToWindow(WindowManager& dest) const
 }	//End: Viewport::BlitToWindow()
 
 
+//--------------------------------------------------------------------------------
+//	@	Viewport::AttachOutput()
+//--------------------------------------------------------------------------------
+//		Rasterize into external memory the size of the viewpane
+//--------------------------------------------------------------------------------
+void Viewport::AttachOutput(uint32_t* pixels)
+{
+	if (pixels == NULL || IsAttached())
+		return;
+
+	detached.Swap(viewpane);
+	viewpane.Borrow(pixels, detached.h(), detached.w());
+	viewpane.Flush();
+	rasterizer.SetOutput(viewpane, zBuffer, &drawn);
+
+}	//End: Viewport::AttachOutput()
+
+
+//--------------------------------------------------------------------------------
+//	@	Viewport::DetachOutput()
+//--------------------------------------------------------------------------------
+//		Rasterize into the viewpane again
+//--------------------------------------------------------------------------------
+void Viewport::DetachOutput()
+{
+	if (!IsAttached())
+		return;
+
+	viewpane.Swap(detached);
+	detached.Borrow(NULL, 0, 0);
+
+	//The window holds what was drawn while attached
+	cleared.AddAll();
+	rasterizer.SetOutput(viewpane, zBuffer, &drawn);
+
+}	//End: Viewport::DetachOutput()
+
+
 //--------------------------------------------------------------------------------
 //	@	Viewport::SetProjectionData()
 //--------------------------------------------------------------------------------
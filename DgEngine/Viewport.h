@@ -40,10 +40,11 @@
 #include "DgTypes.h"
 #include "DgArray.h"
 #include "DgRect.h"
+#include "DirtyRegion.h"
 #include "Text.h"
 #include "Particle_RASTER.h"
+#include "CommonGraphics.h"
 
-namespace DgGraphics{enum BlendType;}
 namespace pugi{class xml_node;}
 struct Polygon;
 class Mesh;
@@ -100,6 +101,9 @@ public:
 	//		Adding content
 	//--------------------------------------------------------------------------------
 
+	//Deactivate polygons in an object that would be clipped away.
+	void CullObject(Mesh*, uint8 planes);
+
 	//Add objects to the rendering lists
 	void AddObject(Mesh*, const Materials&, const Mipmap*, uint8 planes);
 	void AddParticle(const Particle&, const ParticleAlphaTemplate*);
@@ -116,6 +120,10 @@ public:
 
 	//Set a portion of the zBuffer to 0
 	void MaskOut(DgRect);
+
+	//Log an area drawn to outside of the functions above, such as by
+	//drawing on Viewpane() directly.
+	void MarkDrawn(const DgRect& r) {drawn.Add(r);}
 	
 	//--------------------------------------------------------------------------------
 	//		Exporting the viewpane
@@ -126,6 +134,13 @@ public:
 	void BlitToRenderer(Viewport&) const;
 	void BlitToWindow(WindowManager&) const;
 
+	//Draw straight into memory owned elsewhere, typically the locked window
+	//texture, instead of the viewpane. The memory is cleared. Reset()
+	//switches back to the viewpane.
+	void AttachOutput(uint32_t* pixels);
+	void DetachOutput();
+	bool IsAttached() const {return viewpane.IsBorrowed();}
+
 	//--------------------------------------------------------------------------------
 	//		Gets
 	//--------------------------------------------------------------------------------
@@ -171,6 +186,15 @@ private:
 	Image viewpane;			
 	DgArray<int32> zBuffer;
 
+	//Holds the viewpane while the output is attached elsewhere
+	Image detached;
+
+	//Areas of the viewpane drawn to since it was last flushed, and areas
+	//flushed since it was last compiled. Together they cover every pixel
+	//which can differ from the window.
+	DirtyRegion drawn;
+	DirtyRegion cleared;
+
 	//Thread management for rasterization
 	uint32 nThreads;
 	DgArray<Plane4> innerPlanes;
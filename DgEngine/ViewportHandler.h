@@ -79,6 +79,7 @@ public:
 	//Functions to access the internal Viewport Manager.
 	static bool LoadResources(uint32 w, uint32 y);
 	static void SetParentDimensions(uint32 w, uint32 y);
+	static void BeginFrame(WindowManager* w) {viewports.BeginFrame(w);}
 	static void Compile(WindowManager*);
 	static void Reset(bool flush, bool zMasks) {viewports.Reset(flush, zMasks);}
 	static Viewport* GetViewport(viewportID);
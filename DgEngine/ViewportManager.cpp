@@ -24,6 +24,8 @@ void ViewportManager::init(const ViewportManager& other)
 	viewportList = other.viewportList;
 	parent_w = other.parent_w;
 	parent_h = other.parent_h;
+	windowGeneration = 0;
+	recompose = true;
 
 }	//End: ViewportManager::init()
 
@@ -33,7 +35,8 @@ void ViewportManager::init(const ViewportManager& other)
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
-ViewportManager::ViewportManager(): parent_w(0), parent_h(0)
+ViewportManager::ViewportManager(): parent_w(0), parent_h(0), 
+	windowGeneration(0), recompose(true)
 {
 }	//End: ViewportManager::ViewportManager()
 
@@ -85,6 +88,7 @@ void ViewportManager::SetParentDimensions(uint32 w, uint32 h)
 
 	//Set masks
 	SetMasks();
+	recompose = true;
 
 }	//End: ViewportManager::SetParentDimensions()
 
@@ -233,6 +237,7 @@ bool ViewportManager::Activate(viewportID id)
 
 	//Reset z-masks
 	SetMasks();
+	recompose = true;
 
 	return true;
 
@@ -257,6 +262,7 @@ bool ViewportManager::Deactivate(viewportID id)
 
 	//Reset z-masks
 	SetMasks();
+	recompose = true;
 
 	return true;
 
@@ -337,21 +343,84 @@ void ViewportManager::ApplyZMasks()
 }	//End: ViewportManager::ApplyZMasks()
 
 
+//--------------------------------------------------------------------------------
+//	@	ViewportManager::BeginFrame()
+//--------------------------------------------------------------------------------
+//		Attach the first active viewport to the window texture. Later 
+//		viewports are compiled over it, so only the first can skip the copy.
+//--------------------------------------------------------------------------------
+void ViewportManager::BeginFrame(WindowManager* window)
+{
+	if (!window->IsZeroCopy())
+		return;
+
+	for (int32 i = 0; i < viewportList.size(); ++i)
+	{
+		//Check if active
+		Viewport& viewport = viewportList[i].viewport;
+		if (!viewport.IsActive())
+			continue;
+
+		if (viewport.x() == 0 && viewport.y() == 0 
+			&& viewport.w() == window->w() && viewport.h() == window->h())
+		{
+			viewport.AttachOutput(window->LockBuffer());
+		}
+		return;
+	}
+}	//End: ViewportManager::BeginFrame()
+
+
 //--------------------------------------------------------------------------------
 //	@	ViewportManager::Compile()
 //--------------------------------------------------------------------------------
 //		Compile all active viewports to a window.
 //--------------------------------------------------------------------------------
-void ViewportManager::Compile(WindowManager* window) const
+void ViewportManager::Compile(WindowManager* window)
 {
+	//A locked texture holds nothing until written to, and the viewport
+	//attached to it clears the whole window each frame
+	bool all = recompose || window->IsLocked() 
+		|| window->Generation() != windowGeneration;
+
+	recompose = false;
+	windowGeneration = window->Generation();
+
 	for (int32 i = 0; i < viewportList.size(); ++i)
 	{
 		//Check if active
-		if (!viewportList[i].viewport.IsActive())
+		Viewport& viewport = viewportList[i].viewport;
+		if (!viewport.IsActive())
+			continue;
+
+		//Already drawn into the window
+		if (viewport.IsAttached())
 			continue;
 
-		window->UpdateBuffer(viewportList[i].viewport.viewpane, 
-			viewportList[i].viewport.x(), viewportList[i].viewport.y());
+		DirtyRegion& region = viewport.cleared;
+		if (all)
+			region.AddAll();
+		else
+			region.Add(viewport.drawn);
+
+		for (uint32 r = 0; r < region.Size(); ++r)
+		{
+			DgRect rect(region.Get(r));
+			window->UpdateBuffer(viewport.viewpane, viewport.x(), viewport.y(), rect);
+
+			//Viewports above this one have to be sent again where they overlap
+			rect.x += viewport.x();
+			rect.y += viewport.y();
+			for (int32 j = i + 1; j < viewportList.size(); ++j)
+			{
+				Viewport& above = viewportList[j].viewport;
+				if (above.IsActive())
+					above.cleared.Add(rect.x - above.x(), rect.y - above.y(), 
+						rect.x - above.x() + int32(rect.w), rect.y - above.y() + int32(rect.h));
+			}
+		}
+
+		region.Clear();
 	}
 }	//End: ViewportManager::Compile()
 
@@ -91,8 +91,13 @@ public:
 
 	void ApplyZMasks();
 
-	//Compile viewports onto a window
-	void Compile(WindowManager*) const;
+	//Rasterize the first active viewport straight into the window, if it 
+	//covers all of it and the window presents without copying
+	void BeginFrame(WindowManager*);
+
+	//Compile viewports onto a window. Only the parts of each viewpane which
+	//have changed since the last compile are sent.
+	void Compile(WindowManager*);
 
 private:
 
@@ -105,6 +110,11 @@ private:
 	uint32 parent_w;
 	uint32 parent_h;
 
+	//Window texture last compiled to. Everything is sent again if it 
+	//changes, or if the layout changes.
+	uint32 windowGeneration;
+	bool recompose;
+
 	//--------------------------------------------------------------------------------
 	//		Functions
 	//--------------------------------------------------------------------------------
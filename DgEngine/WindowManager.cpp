@@ -14,6 +14,8 @@
 #include "Dg_io.h"
 #include "CommonGraphics.h"
 #include "DgRect.h"
+#include <string.h>
+#include <vector>
 
 //--------------------------------------------------------------------------------
 //		Statics
@@ -35,6 +37,16 @@ void WindowManager::init(uint32 w, uint32 h, bool _fullScreen, std::string _titl
 	//Set flags
 	fullScreen = _fullScreen;
 
+	//No window, only the frame in memory
+	if (headless)
+	{
+		ww = w;
+		wh = h;
+		++generation;
+		AllocateFrame();
+		return;
+	}
+
 	//Set up the screen
 	if (fullScreen)
 	{
@@ -60,21 +72,196 @@ void WindowManager::init(uint32 w, uint32 h, bool _fullScreen, std::string _titl
         std::cerr << "@WindowManager::WindowManager(...) -> Could not create screen" << std::endl;
     }
 
+	//Set data
+	ww = w;
+	wh = h;
+	++generation;
+
+	//The renderer belongs to the thread which presents
+	if (asyncPresent)
+		StartPresenter();
+	else
+		CreateRenderer();
+
+}	//End: WindowManager::init()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::CreateRenderer()
+//--------------------------------------------------------------------------------
+//		Create the renderer and texture on the calling thread
+//--------------------------------------------------------------------------------
+void WindowManager::CreateRenderer()
+{
 	sdlRenderer = SDL_CreateRenderer(sdlScreen, -1, 0);
 
 	sdlTexture = SDL_CreateTexture(sdlRenderer,
                                SDL_PIXELFORMAT_ARGB8888,
                                SDL_TEXTUREACCESS_STREAMING,
-                               w, h);
+                               ww, wh);
 
 	//Letterbox full screenf
-	SDL_RenderSetLogicalSize(sdlRenderer, w, h);
+	SDL_RenderSetLogicalSize(sdlRenderer, ww, wh);
 
-	//Set data
-	ww = w;
-	wh = h;
+}	//End: WindowManager::CreateRenderer()
 
-}	//End: WindowManager::init()
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::DestroyRenderer()
+//--------------------------------------------------------------------------------
+//		Destroy the renderer and texture, on the thread which made them
+//--------------------------------------------------------------------------------
+void WindowManager::DestroyRenderer()
+{
+	//Clear GPU texture
+	SDL_DestroyTexture(sdlTexture);
+
+	//Destroy renderer
+    SDL_RenderClear(sdlRenderer);
+    SDL_DestroyRenderer(sdlRenderer);
+
+	sdlRenderer = NULL;
+	sdlTexture = NULL;
+
+}	//End: WindowManager::DestroyRenderer()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::ReleaseRenderer()
+//--------------------------------------------------------------------------------
+//		Destroy the renderer, stopping the presenting thread if it has it
+//--------------------------------------------------------------------------------
+void WindowManager::ReleaseRenderer()
+{
+	UnlockBuffer();
+
+	if (headless)
+		return;
+
+	if (asyncPresent)
+		StopPresenter();
+	else
+		DestroyRenderer();
+
+}	//End: WindowManager::ReleaseRenderer()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::SetAsyncPresent()
+//--------------------------------------------------------------------------------
+//		Move the renderer to or from a presenting thread
+//--------------------------------------------------------------------------------
+void WindowManager::SetAsyncPresent(bool b)
+{
+	if (b == asyncPresent || headless)
+		return;
+
+	ReleaseRenderer();
+	asyncPresent = b;
+
+	if (asyncPresent)
+		StartPresenter();
+	else
+		CreateRenderer();
+
+	++generation;
+
+}	//End: WindowManager::SetAsyncPresent()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::AllocateFrame()
+//--------------------------------------------------------------------------------
+//		Make a blank frame in memory the size of the window
+//--------------------------------------------------------------------------------
+void WindowManager::AllocateFrame()
+{
+	std::vector<uint32_t> blank(ww * wh, 0);
+	screen.Set(&blank[0], wh, ww);
+	frameChanges.SetBounds(ww, wh);
+
+}	//End: WindowManager::AllocateFrame()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::StartPresenter()
+//--------------------------------------------------------------------------------
+//		Set up the frames and start the presenting thread
+//--------------------------------------------------------------------------------
+void WindowManager::StartPresenter()
+{
+	AllocateFrame();
+	for (uint32 i = 0; i < N_SLOTS; ++i)
+	{
+		slots[i] = screen;
+		slotStale[i].SetBounds(ww, wh);
+	}
+
+	//Slot 0 is written, slot 1 waits in the handoff, slot 2 is presented
+	writeSlot = 0;
+	handoff.store(1);
+	quitPresenter.store(false);
+
+	presenter = std::thread(&WindowManager::Present, this);
+
+}	//End: WindowManager::StartPresenter()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::StopPresenter()
+//--------------------------------------------------------------------------------
+//		Stop the presenting thread. It destroys its renderer on the way out.
+//--------------------------------------------------------------------------------
+void WindowManager::StopPresenter()
+{
+	if (!presenter.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		quitPresenter.store(true);
+	}
+	frameReady.notify_one();
+	presenter.join();
+
+}	//End: WindowManager::StopPresenter()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::Present()
+//--------------------------------------------------------------------------------
+//		Presenting thread. Takes the newest finished frame from the handoff
+//		in exchange for the one it last presented, and presents it. Frames
+//		finished faster than they can be presented are skipped.
+//--------------------------------------------------------------------------------
+void WindowManager::Present()
+{
+	CreateRenderer();
+
+	uint32 readSlot = 2;
+	while (!quitPresenter.load())
+	{
+		//Sleep until a new frame is handed over
+		if ((handoff.load(std::memory_order_acquire) & FRESH) == 0)
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			frameReady.wait(lock, [this]() 
+				{return (handoff.load() & FRESH) != 0 || quitPresenter.load();});
+			continue;
+		}
+
+		readSlot = handoff.exchange(readSlot, std::memory_order_acq_rel) & SLOT_MASK;
+
+		const Image& frame = slots[readSlot];
+		SDL_UpdateTexture(sdlTexture, NULL, frame.pixels(), frame.pitch());
+		SDL_RenderClear(sdlRenderer);
+		SDL_RenderCopy(sdlRenderer, sdlTexture, NULL, NULL);
+		SDL_RenderPresent(sdlRenderer);
+	}
+
+	DestroyRenderer();
+
+}	//End: WindowManager::Present()
 
 
 //--------------------------------------------------------------------------------
@@ -82,8 +269,9 @@ void WindowManager::init(uint32 w, uint32 h, bool _fullScreen, std::string _titl
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
-WindowManager::WindowManager(): sdlScreen(NULL), sdlRenderer(NULL), 
-	sdlTexture(NULL), ww(0), wh(0)
+WindowManager::WindowManager(): headless(false), sdlScreen(NULL), sdlRenderer(NULL), 
+	sdlTexture(NULL), lockedPixels(NULL), zeroCopy(false), generation(0),
+	asyncPresent(false), writeSlot(0), ww(0), wh(0)
 {
 	init(wDefault, hDefault, false, "Default");
 
@@ -95,8 +283,11 @@ WindowManager::WindowManager(): sdlScreen(NULL), sdlRenderer(NULL),
 //--------------------------------------------------------------------------------
 //		Constructor
 //--------------------------------------------------------------------------------
-WindowManager::WindowManager(uint32 w, uint32 h, bool _fullScreen, std::string _title)
-	: sdlScreen(NULL), sdlRenderer(NULL), sdlTexture(NULL), ww(0), wh(0)
+WindowManager::WindowManager(uint32 w, uint32 h, bool _fullScreen, std::string _title,
+							 bool _headless)
+	: headless(_headless), sdlScreen(NULL), sdlRenderer(NULL), sdlTexture(NULL), 
+	lockedPixels(NULL), zeroCopy(false), generation(0), asyncPresent(false), 
+	writeSlot(0), ww(0), wh(0)
 {
 	init(w, h, _fullScreen, _title);
 
@@ -109,7 +300,9 @@ WindowManager::WindowManager(uint32 w, uint32 h, bool _fullScreen, std::string _
 //		Copy constructor
 //--------------------------------------------------------------------------------
 WindowManager::WindowManager(const WindowManager& other)
-	: sdlScreen(NULL), sdlRenderer(NULL), sdlTexture(NULL), ww(0), wh(0)
+	: headless(other.headless), sdlScreen(NULL), sdlRenderer(NULL), sdlTexture(NULL), 
+	lockedPixels(NULL), zeroCopy(other.zeroCopy), generation(0), asyncPresent(other.asyncPresent), 
+	writeSlot(0), ww(0), wh(0)
 {
 	init(other.ww, other.wh, other.fullScreen, other.title);
 
@@ -139,15 +332,11 @@ WindowManager& WindowManager::operator=(const WindowManager& other)
 //--------------------------------------------------------------------------------
 void WindowManager::Set(uint32 w, uint32 h, bool _fullScreen, std::string _title)
 {
-	
-	SDL_DestroyTexture(sdlTexture);
-    SDL_RenderClear(sdlRenderer);
-    SDL_DestroyRenderer(sdlRenderer);
-    SDL_DestroyWindow(sdlScreen);
+	ReleaseRenderer();
+	if (sdlScreen)
+		SDL_DestroyWindow(sdlScreen);
 
 	sdlScreen = NULL;
-	sdlRenderer = NULL;
-	sdlTexture = NULL;
 
 	init(w, h, _fullScreen, _title);
 
@@ -186,6 +375,58 @@ void WindowManager::ToggleFullScreen()
 //--------------------------------------------------------------------------------
 void WindowManager::FlipScreen()
 {
+	bool drawnInSlot = asyncPresent && lockedPixels == slots[writeSlot].pixels();
+
+	UnlockBuffer();
+
+	//Nothing to show. The frame stays in memory to be read.
+	if (headless)
+		return;
+
+	//Hand the frame over and carry on. The slot given back is free to
+	//write, it is either the oldest frame or one which was skipped.
+	if (asyncPresent)
+	{
+		if (drawnInSlot)
+		{
+			//The frame in memory missed this one, start it again
+			for (uint32 i = 0; i < N_SLOTS; ++i)
+				slotStale[i].AddAll();
+			frameChanges.Clear();
+			++generation;
+		}
+		else
+		{
+			//Bring the slot up to date. Slots skipped over for a few frames
+			//carry what changed in them.
+			for (uint32 i = 0; i < N_SLOTS; ++i)
+				slotStale[i].Add(frameChanges);
+			frameChanges.Clear();
+
+			DirtyRegion& stale = slotStale[writeSlot];
+			uint32_t* dest = slots[writeSlot].pixels();
+			const uint32_t* src = screen.pixels();
+			for (uint32 r = 0; r < stale.Size(); ++r)
+			{
+				DgRect rect(stale.Get(r));
+				for (uint32 i = 0; i < rect.h; ++i)
+				{
+					uint32 offset = (rect.y + i) * ww + rect.x;
+					memcpy(dest + offset, src + offset, rect.w * sizeof(uint32_t));
+				}
+			}
+			stale.Clear();
+		}
+
+		writeSlot = handoff.exchange(writeSlot | FRESH, std::memory_order_acq_rel) & SLOT_MASK;
+
+		{
+			std::lock_guard<std::mutex> lock(wakeMutex);
+		}
+		frameReady.notify_one();
+		return;
+	}
+
 	SDL_RenderClear(sdlRenderer);
 	SDL_RenderCopy(sdlRenderer, sdlTexture, NULL, NULL);
 	SDL_RenderPresent(sdlRenderer);
@@ -200,15 +441,12 @@ void WindowManager::FlipScreen()
 //--------------------------------------------------------------------------------
 WindowManager::~WindowManager()
 {
-	//Clear GPU texture
-	SDL_DestroyTexture(sdlTexture);
-
 	//Destroy renderer
-    SDL_RenderClear(sdlRenderer);
-    SDL_DestroyRenderer(sdlRenderer);
+	ReleaseRenderer();
 
 	//Destroy window
-    SDL_DestroyWindow(sdlScreen);
+	if (sdlScreen)
+		SDL_DestroyWindow(sdlScreen);
 
 }	//End: WindowManager::~WindowManager()
 
@@ -219,20 +457,125 @@ WindowManager::~WindowManager()
 //		Add and Image to the buffer
 //--------------------------------------------------------------------------------
 void WindowManager::UpdateBuffer(const Image& img, uint32 x, uint32 y)
+{
+	UpdateBuffer(img, x, y, DgRect(0, 0, img.w(), img.h()));
+
+}	//End: WindowManager::UpdateBuffer()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::UpdateBuffer()
+//--------------------------------------------------------------------------------
+//		Add part of an Image to the buffer. The part is in Image 
+//		coordinates and must lie inside the Image.
+//--------------------------------------------------------------------------------
+void WindowManager::UpdateBuffer(const Image& img, uint32 x, uint32 y, const DgRect& part)
 {
 	//Get portion of the screen to render to
 	SDL_Rect rect;
-	rect.x = x;
-	rect.y = y;
-	rect.h = img.h();
-	rect.w = img.w();
+	rect.x = x + part.x;
+	rect.y = y + part.y;
+	rect.h = part.h;
+	rect.w = part.w;
 
 	//Clip if necessary
 	if (!ClipRect(rect, ww, wh))
 		return;
 
+	const uint32_t* src = img.pixels() + (rect.y - y) * img.w() + (rect.x - x);
+
+	//Write straight into locked memory, or the frame if it is in memory
+	uint32_t* frame = lockedPixels;
+	if (frame == NULL && IsFrameInMemory())
+	{
+		frame = screen.pixels();
+		frameChanges.Add(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
+	}
+
+	if (frame)
+	{
+		if (img.pixels() == frame)
+			return;
+
+		for (int32 i = 0; i < rect.h; ++i)
+		{
+			memcpy(frame + (rect.y + i) * ww + rect.x, 
+				src + i * img.w(), rect.w * sizeof(uint32_t));
+		}
+		return;
+	}
+
 	//Update texture
-	SDL_UpdateTexture(sdlTexture, &rect, img.pixels(),
-		img.pitch() );
+	SDL_UpdateTexture(sdlTexture, &rect, src, img.pitch() );
+
+}	//End: WindowManager::UpdateBuffer()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::LockBuffer()
+//--------------------------------------------------------------------------------
+//		Lock the texture for writing. Returns NULL if zero copy presentation 
+//		is off, or the texture rows are not packed.
+//--------------------------------------------------------------------------------
+uint32_t* WindowManager::LockBuffer()
+{
+	if (lockedPixels)
+		return lockedPixels;
+
+	if (!zeroCopy)
+		return NULL;
+
+	//The frame is already in memory
+	if (headless)
+	{
+		lockedPixels = screen.pixels();
+		return lockedPixels;
+	}
+
+	//Draw into the next frame handed over. Its pixels are stale.
+	if (asyncPresent)
+	{
+		lockedPixels = slots[writeSlot].pixels();
+		return lockedPixels;
+	}
+
+	if (sdlTexture == NULL)
+		return NULL;
+
+	void* pixels;
+	int pitch;
+	if (SDL_LockTexture(sdlTexture, NULL, &pixels, &pitch) != 0)
+		return NULL;
+
+	//Images have no row padding
+	if (uint32(pitch) != ww * sizeof(uint32_t))
+	{
+		SDL_UnlockTexture(sdlTexture);
+		zeroCopy = false;
+		std::cerr << "@WindowManager::LockBuffer() -> Texture rows are padded, "
+			"zero copy presentation disabled" << std::endl;
+		return NULL;
+	}
+
+	lockedPixels = static_cast<uint32_t*>(pixels);
+	return lockedPixels;
+
+}	//End: WindowManager::LockBuffer()
+
+
+//--------------------------------------------------------------------------------
+//	@	WindowManager::UnlockBuffer()
+//--------------------------------------------------------------------------------
+//		Hand the texture back to the renderer
+//--------------------------------------------------------------------------------
+void WindowManager::UnlockBuffer()
+{
+	if (lockedPixels == NULL)
+		return;
+
+	if (!IsFrameInMemory())
+		SDL_UnlockTexture(sdlTexture);
+
+	lockedPixels = NULL;
 
-}	//End: WindowManager::ApplyToBuffer()
\ No newline at end of file
+}	//End: WindowManager::UnlockBuffer()
\ No newline at end of file
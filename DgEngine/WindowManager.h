@@ -19,9 +19,13 @@
 #include "SDL.h"
 #include "DgTypes.h"
 #include "Image.h"
+#include "DgRect.h"
+#include "DirtyRegion.h"
 #include <string>
-
-namespace DgGraphics{enum BlendType;}
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 //--------------------------------------------------------------------------------
@@ -33,7 +37,8 @@ class WindowManager
 public:
 	//Constructor / destructor
 	WindowManager();
-	WindowManager(uint32 w, uint32 h, bool fullScreen, std::string title); 
+	WindowManager(uint32 w, uint32 h, bool fullScreen, std::string title,
+		bool headless = false); 
 	~WindowManager();
 
 	//Copy operations
@@ -48,8 +53,38 @@ public:
 	//Render the buffer
 	void FlipScreen();
 
-	//Add an Image to the buffer
+	//Asynchronous presentation. The renderer is moved to a thread of its 
+	//own. Viewports are compiled into a frame in memory, and FlipScreen()
+	//hands a copy of what changed to the thread and returns without 
+	//waiting for it to be presented.
+	void SetAsyncPresent(bool);
+	bool IsAsyncPresent() const {return asyncPresent;}
+
+	//A headless window has no SDL window or renderer. Viewports are 
+	//compiled into the frame in memory, where it can be read after 
+	//FlipScreen(). Needs no display.
+	bool IsHeadless() const {return headless;}
+	bool IsFrameInMemory() const {return headless || asyncPresent;}
+	const Image& Frame() const {return screen;}
+
+	//Add an Image, or part of one, to the buffer
 	void UpdateBuffer(const Image&, uint32 x, uint32 y);
+	void UpdateBuffer(const Image&, uint32 x, uint32 y, const DgRect& part);
+
+	//Zero copy presentation. While the texture is locked, its memory can be
+	//drawn to directly and UpdateBuffer() writes into it. FlipScreen()
+	//unlocks it. The pixels of a locked texture are undefined. With
+	//asynchronous presentation, the next frame handed to the presenting
+	//thread is locked instead, and is handed over without a copy.
+	void SetZeroCopy(bool b) {zeroCopy = b;}
+	bool IsZeroCopy() const {return zeroCopy;}
+	uint32_t* LockBuffer();
+	void UnlockBuffer();
+	bool IsLocked() const {return lockedPixels != NULL;}
+
+	//Changes whenever the texture is created again. A new texture holds
+	//nothing which was added to the old one.
+	uint32 Generation() const {return generation;}
 
 	//Return functions
 	uint32 w() const {return ww;}
@@ -61,11 +96,40 @@ private:
 	//Data members
 	std::string title;
 	bool fullScreen;
+	bool headless;
 
 	SDL_Window*		sdlScreen;		//The window
 	SDL_Renderer*	sdlRenderer;	//Viewport
 	SDL_Texture*	sdlTexture;		//Stored on the GPU
 
+	//Texture memory, while locked
+	uint32_t* lockedPixels;
+	bool zeroCopy;
+	uint32 generation;
+
+	//Frame viewports are compiled into when it is kept in memory
+	Image screen;
+	DirtyRegion frameChanges;	//Written to screen since the last flip
+
+	//Asynchronous presentation. Three frames are passed round between the
+	//threads: one written by the main thread, one presented, and the 
+	//newest finished frame waiting in the handoff.
+	enum
+	{
+		N_SLOTS = 3,
+		SLOT_MASK = 3,
+		FRESH = 4		//Set in the handoff until the frame is taken
+	};
+	bool asyncPresent;
+	Image slots[N_SLOTS];
+	DirtyRegion slotStale[N_SLOTS];	//Where each slot differs from screen
+	uint32 writeSlot;
+	std::atomic<uint32> handoff;
+	std::atomic<bool> quitPresenter;
+	std::thread presenter;
+	std::mutex wakeMutex;
+	std::condition_variable frameReady;
+
 	//Size of the window.
 	uint32 ww;
 	uint32 wh;
@@ -80,6 +144,15 @@ private:
 
 	//Initialise screen
 	void init(uint32 w, uint32 h, bool fullScreen, std::string title);
+
+	void AllocateFrame();
+	void CreateRenderer();
+	void DestroyRenderer();
+	void ReleaseRenderer();
+
+	void StartPresenter();
+	void StopPresenter();
+	void Present();
 };
 
 //--------------------------------------------------------------------------------
@@ -7,6 +7,9 @@
 
 #include "Timer.h"
 #include "WindowManager.h"
+#include "ResourceLoader.h"
+#include "ImageManager.h"
+#include "SettingsParser.h"
 
 int main( int argc, char* args[] ) 
 { 
@@ -15,12 +18,38 @@ int main( int argc, char* args[] )
     CERR_NEW_BUF.open("errorlog.txt", std::ios::out);;
     std::streambuf* CERR_OLD_BUF = std::cerr.rdbuf(&CERR_NEW_BUF);
 
+	//Replay a raster capture or pack assets, nothing else needs to start
+	SettingsParser options;
+	options.ParseArgs(argc, args);
+	std::string str;
+	if (options.GetValue("raster_replay", str))
+	{
+		int result = RUN_RASTER_REPLAY(options);
+		std::cerr.rdbuf(CERR_OLD_BUF);
+		return result;
+	}
+	if (options.GetValue("pack", str))
+	{
+		int result = RUN_PACK(options);
+		std::cerr.rdbuf(CERR_OLD_BUF);
+		return result;
+	}
+
 	//Load resources, create screen
-    if (!START())
+    if (!START(argc, args))
     {
         return 1;
     }
 
+	//Render offscreen to image files, no window or title
+	if (WINDOW->IsHeadless())
+	{
+		int result = RUN_HEADLESS();
+		SHUTDOWN();
+		std::cerr.rdbuf(CERR_OLD_BUF);
+		return result;
+	}
+
 	//Create StateInfo Object
 	StateInfo stateinfo(STATE_TITLE);
 
@@ -33,6 +62,13 @@ int main( int argc, char* args[] )
 	//Game loop
 	while (stateinfo.stateID != STATE_EXIT)
 	{
+		//Hand over resources which finished loading, release unused ones
+		global::LOADER->Update();
+		global::IMAGE_MANAGER->NewFrame();
+
+		//Draw the full window viewport straight into the window texture
+		ViewportHandler::BeginFrame(WINDOW);
+
 		//Do state event handling
 		currentstate->HandleEvents(stateinfo, event);
 
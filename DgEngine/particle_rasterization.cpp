@@ -4,6 +4,7 @@
 #include "ParticleAlphaTemplate.h"
 #include "Particle_RASTER.h"
 #include "rasterizer_defines.h"
+#include "DirtyRegion.h"
 
 //--------------------------------------------------------------------------------
 //	@	Rasterizer::Draw()
@@ -76,6 +77,9 @@ void Rasterizer::DrawParticle(const Particle_RASTER& input)
 	if (xe == xs || y_start == y_end)
 		return;
 
+	if (dirty)
+		dirty->Add(xs, y_start, xe + 1, y_end + 1);
+
 	//Find alpha template interpolants
 	dudy_right = (ue - us) / (xe - xs);				//x-interpolant
 	dvdy_right = (ve - vs) / (y_end - y_start);	//y-interpolant
@@ -25,6 +25,7 @@
 #include "Materials.h"
 #include "Image.h"
 #include "rasterizer_defines.h"
+#include "DirtyRegion.h"
 
 
 //--------------------------------------------------------------------------------
@@ -74,6 +75,35 @@ void Rasterizer::AddSignature(uint8 val)
 }	//End: Rasterizer::AddSignature()
 
 
+//--------------------------------------------------------------------------------
+//	@	Rasterizer::MarkDirty()
+//--------------------------------------------------------------------------------
+//		Log the pixels a triangle can touch. One pixel of slack is added
+//		on the far sides for the rounding of the edges.
+//--------------------------------------------------------------------------------
+void Rasterizer::MarkDirty(const Vertex_RASTER& a, const Vertex_RASTER& b, 
+						   const Vertex_RASTER& c)
+{
+	if (dirty == NULL)
+		return;
+
+	float x_min = a.pos.X(), x_max = a.pos.X();
+	float y_min = a.pos.Y(), y_max = a.pos.Y();
+
+	if (b.pos.X() < x_min) x_min = b.pos.X();
+	if (b.pos.X() > x_max) x_max = b.pos.X();
+	if (c.pos.X() < x_min) x_min = c.pos.X();
+	if (c.pos.X() > x_max) x_max = c.pos.X();
+	if (b.pos.Y() < y_min) y_min = b.pos.Y();
+	if (b.pos.Y() > y_max) y_max = b.pos.Y();
+	if (c.pos.Y() < y_min) y_min = c.pos.Y();
+	if (c.pos.Y() > y_max) y_max = c.pos.Y();
+
+	dirty->Add(int32(x_min), int32(y_min), int32(x_max) + 2, int32(y_max) + 2);
+
+}	//End: Rasterizer::MarkDirty()
+
+
 //--------------------------------------------------------------------------------
 //		Functions
 //--------------------------------------------------------------------------------
@@ -440,6 +470,8 @@ void Rasterizer::DrawPolygon(const Polygon_RASTER& input )
 	p1 = &input.p1;
 	p2 = &input.p2;
 
+	MarkDirty(input.p0, input.p1, input.p2);
+
 	//Determine mipmap
 	float screen_area_by2 =  
 			(	input.p0.pos.X()*(input.p1.pos.Y() - input.p2.pos.Y()) + 
@@ -598,6 +630,8 @@ void Rasterizer::DrawSkyBoxPolygon(const Polygon_RASTER_SB& input)
 	p1 = &input.p1;
 	p2 = &input.p2;
 
+	MarkDirty(input.p0, input.p1, input.p2);
+
 	//Check for valid texture
 	if (input.image == NULL)
 	{
@@ -732,8 +766,10 @@ void Rasterizer::DrawSkyBoxPolygon(const Polygon_RASTER_SB& input)
 //--------------------------------------------------------------------------------
 //		Sets all data needed for output
 //--------------------------------------------------------------------------------
-void Rasterizer::SetOutput(Image& out, DgArray<int32>& z)
+void Rasterizer::SetOutput(Image& out, DgArray<int32>& z, DirtyRegion* d)
 {
+	dirty = d;
+
 	if (z.max_size() < out.w() * out.h())
 	{
 		output_pixels = NULL;